@@ -0,0 +1,275 @@
+#include "CompiledExpression.hpp"
+#include "KalkContext.hpp"
+#include "Setup.hpp"
+#include "ValueArena.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <ostream>
+#include <regex>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <mpreal.h>
+#include <boost/format.hpp>
+#include <boost/program_options.hpp>
+
+// Discards everything written to it, so printing can be measured without a terminal or a pipe in the way.
+class NullBuffer : public std::streambuf
+{
+  protected:
+  int_type overflow(int_type value) override { return traits_type::not_eof(value); }
+  std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+};
+
+// Runs each benchmark in doubling batches until a batch takes at least the minimum time, then writes one CSV row with the time per iteration of that
+// batch. Values created by an iteration are released at the end of it, the same way main releases them after each statement.
+class BenchmarkRunner
+{
+  public:
+  BenchmarkRunner(std::ostream& output, const std::string& filter, double minimumSeconds)
+      : m_Output(output)
+      , m_Filter(filter)
+      , m_MinimumTime(minimumSeconds)
+  {}
+
+  void SetPrecision(mpfr_prec_t value) { m_Precision = value; }
+
+  void Run(const std::string& name, const std::function<const void*()>& callback)
+  {
+    if(!std::regex_search(name, m_Filter))
+    {
+      return;
+    }
+
+    std::size_t iterations = 1u;
+    while(true)
+    {
+      const auto start = std::chrono::steady_clock::now();
+      for(std::size_t i = 0u; i < iterations; i++)
+      {
+        const ValueArena::Scope arenaScope(m_Arena);
+        s_Sink = callback();
+      }
+
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      if(elapsed >= m_MinimumTime)
+      {
+        m_Output << (boost::format("%1%,%2%,%3%,%4$.1f") % name % m_Precision % iterations % (elapsed.count() * 1e9 / static_cast<double>(iterations)))
+                 << std::endl;
+        return;
+      }
+
+      iterations *= 2u;
+    }
+  }
+
+  private:
+  static inline const void* volatile s_Sink = nullptr;
+
+  std::ostream& m_Output;
+  std::regex m_Filter;
+  std::chrono::duration<double> m_MinimumTime;
+  mpfr_prec_t m_Precision = 0;
+  ValueArena m_Arena;
+};
+
+template<class T>
+static IValueToken* argument(std::vector<std::unique_ptr<DefaultValueType>>& storage, T&& value)
+{
+  storage.push_back(std::make_unique<DefaultValueType>(std::forward<T>(value)));
+  return storage.back().get();
+}
+
+static void benchmarkParsing(BenchmarkRunner& runner)
+{
+  static const std::vector<std::pair<std::string, std::string>> kExpressions = {
+      {"parse/arithmetic", "1 + 2 * 3 - 4 / 5 ** 6"},
+      {"parse/nested", "(((1 + 2) * (3 - 4)) / ((5 % 6) ** 7)) << 2"},
+      {"parse/functions", "math.sin(1.5) ** 2 + math.cos(1.5) ** 2 - math.sqrt(math.abs(-2))"},
+      {"parse/aggregate", "max(1, 2, 3, 4, 5, 6, 7, 8) - math.median(8, 7, 6, 5, 4, 3, 2, 1)"},
+      {"parse/statements", "1 + 1; 2 + 2; 3 + 3; 4 + 4"},
+  };
+
+  for(const auto& i : kExpressions)
+  {
+    const auto& expression = i.second;
+    if(CompiledExpression::Compile(expression) == nullptr)
+    {
+      throw std::runtime_error("Could not compile benchmark expression: " + expression);
+    }
+
+    runner.Run(i.first, [&expression]() { return static_cast<const void*>(CompiledExpression::Compile(expression).get()); });
+  }
+}
+
+static void benchmarkBinaryOperators(BenchmarkRunner& runner,
+                                     const std::string& family,
+                                     const std::vector<std::string>& identifiers,
+                                     IValueToken* lhs,
+                                     IValueToken* rhs,
+                                     const std::string& suffix = "")
+{
+  const auto& context = currentContext();
+  for(const auto& i : identifiers)
+  {
+    const auto& callback = context.defaultBinaryOperatorCallbacks.at(i);
+    runner.Run(family + "/" + i + suffix, [&callback, lhs, rhs]() { return callback(lhs, rhs); });
+  }
+}
+
+static void benchmarkOperators(BenchmarkRunner& runner, mpfr_prec_t precision)
+{
+  std::vector<std::unique_ptr<DefaultValueType>> storage;
+  const auto x = argument(storage, DefaultArithmeticType(mpfr::const_pi()));
+  const auto y = argument(storage, DefaultArithmeticType(mpfr::sqrt(DefaultArithmeticType(2))));
+  benchmarkBinaryOperators(runner, "arithmetic", {"+", "-", "*", "/", "//", "%", "%%", "**"}, x, y);
+  benchmarkBinaryOperators(runner, "comparison", {"==", "!=", "<", ">", "<=", ">="}, x, y);
+  benchmarkBinaryOperators(runner, "logical", {"||", "&&"}, x, y);
+
+  const auto m = argument(storage, DefaultIntegerType((DefaultIntegerType(1) << static_cast<mp_bitcnt_t>(precision)) / 3));
+  const auto n = argument(storage, DefaultIntegerType((DefaultIntegerType(1) << static_cast<mp_bitcnt_t>(precision)) / 7));
+  const auto shift = argument(storage, DefaultIntegerType(17));
+  benchmarkBinaryOperators(runner, "bitwise", {"|", "&", "^"}, m, n);
+  benchmarkBinaryOperators(runner, "bitwise", {"<<", ">>"}, m, shift);
+
+  const auto dateTime = argument(storage, boost::posix_time::ptime(boost::gregorian::date(2000, 1, 1), boost::posix_time::hours(12)));
+  const auto epoch    = argument(storage, boost::posix_time::ptime(boost::gregorian::date(1970, 1, 1)));
+  const auto duration = argument(storage, boost::posix_time::time_duration(36, 15, 30));
+  const auto factor   = argument(storage, DefaultArithmeticType(2.5));
+  benchmarkBinaryOperators(runner, "datetime", {"-"}, dateTime, epoch, "(date;date)");
+  benchmarkBinaryOperators(runner, "datetime", {"+", "-"}, dateTime, duration, "(date;duration)");
+  benchmarkBinaryOperators(runner, "datetime", {"+", "-"}, duration, duration, "(duration;duration)");
+  benchmarkBinaryOperators(runner, "datetime", {"*", "/"}, duration, factor, "(duration;number)");
+}
+
+static void benchmarkAggregates(BenchmarkRunner& runner)
+{
+  const auto& context = currentContext();
+  for(const std::size_t count : {4u, 64u, 1024u})
+  {
+    std::vector<std::unique_ptr<DefaultValueType>> storage;
+    std::vector<IValueToken*> args;
+    for(std::size_t i = 0u; i < count; i++)
+    {
+      args.push_back(argument(storage, DefaultArithmeticType(DefaultArithmeticType(static_cast<unsigned long>(i * 7919u % 1009u)) / 7)));
+    }
+
+    for(const auto& i : {"min", "max", "math.mean", "math.median", "math.mode", "math.q1", "math.stddev"})
+    {
+      const auto& callback = context.defaultFunctionCallbacks.at(i);
+      runner.Run((boost::format("aggregate/%1%/%2%") % i % count).str(), [&callback, &args]() { return callback(args); });
+    }
+  }
+}
+
+static void benchmarkMolarMass(BenchmarkRunner& runner)
+{
+  const auto& callback = currentContext().defaultFunctionCallbacks.at("chem.M");
+  for(const auto& i : {"H2O", "C6H12O6", "Ca3(PO4)2", "K4Fe(CN)6"})
+  {
+    std::vector<std::unique_ptr<DefaultValueType>> storage;
+    const std::vector<IValueToken*> args {argument(storage, std::string(i))};
+    runner.Run(std::string("chem.M/") + i, [&callback, &args]() { return callback(args); });
+  }
+}
+
+static void benchmarkConversion(BenchmarkRunner& runner)
+{
+  auto& context = currentContext();
+  std::vector<std::unique_ptr<DefaultValueType>> storage;
+  const auto pi      = argument(storage, DefaultArithmeticType(mpfr::const_pi()));
+  const auto integer = argument(storage, DefaultIntegerType((DefaultIntegerType(1) << static_cast<mp_bitcnt_t>(context.options.precision)) - 1));
+  const auto vector  = argument(storage, DefaultVectorType(std::vector<DefaultArithmeticType>(8u, mpfr::const_pi())));
+
+  // Literals are rotated through more distinct values than the number converter's intern table holds, so every conversion parses. The interned
+  // benchmark repeats one literal and measures the table hit instead.
+  constexpr std::size_t kLiteralCount = 1u << 14u;
+  std::vector<std::string> shortLiterals;
+  std::vector<std::string> fullLiterals;
+  for(std::size_t i = 0u; i < kLiteralCount; i++)
+  {
+    shortLiterals.push_back((boost::format("%|05|.678") % i).str());
+    fullLiterals.push_back((mpfr::const_pi() + static_cast<unsigned long>(i)).toString(context.options.digits));
+  }
+
+  const auto& converter = context.defaultNumberConverter;
+  runner.Run("convert/short", [&converter, &shortLiterals, i = std::size_t(0u)]() mutable { return converter(shortLiterals[i++ % kLiteralCount]); });
+  runner.Run("convert/full", [&converter, &fullLiterals, i = std::size_t(0u)]() mutable { return converter(fullLiterals[i++ % kLiteralCount]); });
+  runner.Run("convert/short/interned", [&converter]() { return converter("12345.678"); });
+
+  NullBuffer buffer;
+  const auto previous = std::cout.rdbuf(&buffer);
+  for(const int base : {10, 16})
+  {
+    context.options.output_base = base;
+    for(const auto& [name, value] : {std::make_pair("arithmetic", pi), std::make_pair("integer", integer), std::make_pair("vector", vector)})
+    {
+      runner.Run((boost::format("print/%1%/base%2%") % name % base).str(), [value = value]() {
+        printValue(*value->As<DefaultValueType*>());
+        return value;
+      });
+    }
+  }
+
+  context.options.output_base = defaultOptions.output_base;
+  std::cout.rdbuf(previous);
+}
+
+int main(int argc, char* argv[])
+{
+  std::string filter;
+  double minimumSeconds;
+  std::vector<mpfr_prec_t> precisions;
+
+  boost::program_options::options_description namedArgDescs("Options");
+  namedArgDescs.add_options()("filter,f", boost::program_options::value<std::string>(&filter)->default_value(""), "Run benchmarks matching regex only");
+  namedArgDescs.add_options()("time,t", boost::program_options::value<double>(&minimumSeconds)->default_value(0.1), "Set minimum time per benchmark (s)");
+  namedArgDescs.add_options()("prec,p",
+                              boost::program_options::value<std::vector<mpfr_prec_t>>(&precisions)
+                                  ->multitoken()
+                                  ->default_value(std::vector<mpfr_prec_t> {64, 256, 1024, 4096}, "64 256 1024 4096"),
+                              "Set precisions to run at");
+  namedArgDescs.add_options()("help,h", "Print usage");
+
+  boost::program_options::variables_map argVariableMap;
+  boost::program_options::store(boost::program_options::parse_command_line(argc, argv, namedArgDescs), argVariableMap);
+  boost::program_options::notify(argVariableMap);
+  if(argVariableMap.count("help") > 0u)
+  {
+    std::cout << (boost::format("Usage: %1%_bench [-fpt]") % PROJECT_EXECUTABLE) << std::endl << namedArgDescs << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  KalkContext context;
+  const KalkContext::Scope contextScope(context);
+  ExpressionParser expressionParser;
+  InitDefaultExpressionParser(expressionParser, context);
+
+  // Printing benchmarks redirect std::cout, so results go through a stream of their own.
+  std::ostream output(std::cout.rdbuf());
+  BenchmarkRunner runner(output, filter, minimumSeconds);
+  output << "benchmark,precision,iterations,ns_per_iteration" << std::endl;
+  for(const auto precision : precisions)
+  {
+    context.options.precision = precision;
+    context.options.digits    = static_cast<int>(static_cast<double>(precision) * std::log10(2.0));
+    context.ApplyPrecision();
+    runner.SetPrecision(precision);
+
+    benchmarkParsing(runner);
+    benchmarkOperators(runner, precision);
+    benchmarkAggregates(runner);
+    benchmarkMolarMass(runner);
+    benchmarkConversion(runner);
+  }
+
+  return EXIT_SUCCESS;
+}
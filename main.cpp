@@ -1,6 +1,14 @@
+#include "BatchEvaluator.hpp"
+#include "BinaryIO.hpp"
+#include "CompiledExpression.hpp"
+#include "KalkContext.hpp"
+#include "LineReader.hpp"
 #include "Setup.hpp"
+#include "Trace.hpp"
+#include "ValueArena.hpp"
 #include "math/Common.hpp"
 
+#include <algorithm>
 #include <cerrno>
 #include <cstdio>
 #include <cstdlib>
@@ -12,6 +20,8 @@
 #include <random>
 #include <regex>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -35,35 +45,12 @@ static const std::unordered_map<mpfr_rnd_t, std::string> rmodeNameMap = {
     {mpfr_rnd_t::MPFR_RNDNA, "NA"},
 };
 
-static const std::unordered_map<std::string, mpfr_rnd_t> rmodeNameMap2 = {
-    {"N", mpfr_rnd_t::MPFR_RNDN},
-    {"Z", mpfr_rnd_t::MPFR_RNDZ},
-    {"U", mpfr_rnd_t::MPFR_RNDU},
-    {"D", mpfr_rnd_t::MPFR_RNDD},
-    {"A", mpfr_rnd_t::MPFR_RNDA},
-    {"F", mpfr_rnd_t::MPFR_RNDF},
-    {"NA", mpfr_rnd_t::MPFR_RNDNA},
-};
-
 static const std::unordered_map<Associativity, std::string> associativityNameMap = {
     {Associativity::Left, "Left"},
     {Associativity::Right, "Right"},
     {Associativity::Any, "Any"},
 };
 
-mpfr_rnd_t strToRmode(const std::string value)
-{
-  const auto iter = rmodeNameMap2.find(boost::to_upper_copy(value));
-  if(iter != rmodeNameMap2.cend())
-  {
-    return iter->second;
-  }
-  else
-  {
-    throw std::domain_error("Invalid rounding mode");
-  }
-}
-
 static std::istream& operator>>(std::istream& stream, mpfr_rnd_t& result)
 {
   std::string value;
@@ -124,6 +111,72 @@ void resolveEnvironmentVariables(std::vector<std::string>& result)
     result.push_back(pTmp);
   }
 
+  if((pTmp = std::getenv("KALK_CACHE")) != nullptr)
+  {
+    result.push_back("KALK_CACHE");
+    result.push_back(pTmp);
+  }
+
+  if((pTmp = std::getenv("KALK_COMPILE")) != nullptr)
+  {
+    result.push_back("KALK_COMPILE");
+    result.push_back(pTmp);
+  }
+
+  if((pTmp = std::getenv("KALK_MEMO")) != nullptr)
+  {
+    result.push_back("KALK_MEMO");
+    result.push_back(pTmp);
+  }
+
+  if((pTmp = std::getenv("KALK_THREADS")) != nullptr)
+  {
+    result.push_back("KALK_THREADS");
+    result.push_back(pTmp);
+  }
+
+  if((pTmp = std::getenv("KALK_AGG_THREADS")) != nullptr)
+  {
+    result.push_back("KALK_AGG_THREADS");
+    result.push_back(pTmp);
+  }
+
+  if((pTmp = std::getenv("KALK_HISTORY")) != nullptr)
+  {
+    result.push_back("KALK_HISTORY");
+    result.push_back(pTmp);
+  }
+
+  if((pTmp = std::getenv("KALK_HISTORY_FILE")) != nullptr)
+  {
+    result.push_back("KALK_HISTORY_FILE");
+    result.push_back(pTmp);
+  }
+
+  if((pTmp = std::getenv("KALK_OFMT")) != nullptr)
+  {
+    result.push_back("KALK_OFMT");
+    result.push_back(pTmp);
+  }
+
+  if((pTmp = std::getenv("KALK_IFMT")) != nullptr)
+  {
+    result.push_back("KALK_IFMT");
+    result.push_back(pTmp);
+  }
+
+  if((pTmp = std::getenv("KALK_BIND")) != nullptr)
+  {
+    result.push_back("KALK_BIND");
+    result.push_back(pTmp);
+  }
+
+  if((pTmp = std::getenv("KALK_ENGINE")) != nullptr)
+  {
+    result.push_back("KALK_ENGINE");
+    result.push_back(pTmp);
+  }
+
   if((pTmp = std::getenv("KALK_INTERACTIVE")) != nullptr)
   {
     result.push_back("KALK_INTERACTIVE");
@@ -137,51 +190,239 @@ void resolveEnvironmentVariables(std::vector<std::string>& result)
   }
 }
 
-static void handleResult(const DefaultValueType* value, bool verbose)
+static void handleResult(const IValueToken* value, bool verbose)
 {
-  results.push_back(*value);
-  if(verbose)
+  auto& context     = currentContext();
+  const auto native = value->As<const NativeValueType*>();
+  if(native != nullptr)
+  {
+    context.results.Push(toDefaultValue(*native));
+  }
+  else
+  {
+    context.results.Push(*value->As<const DefaultValueType*>());
+  }
+
+  if(!verbose)
+  {
+    return;
+  }
+
+  if(isBinaryFormat(context.options.ofmt))
+  {
+    const TraceSpan span("output", "write");
+    writeBinaryValue(stdout, value, context.options.ofmt);
+  }
+  else if(native != nullptr)
   {
-    printValue(*value);
+    printValue(*native);
+  }
+  else
+  {
+    printValue(*value->As<const DefaultValueType*>());
   }
 }
 
 static void removeUninitializedVariables()
 {
-  if(!defaultUninitializedVariableCache.empty())
+  auto& context = currentContext();
+  if(!context.defaultUninitializedVariableCache.empty())
   {
     std::cout << "*** Warning: Uninitialized variable(s)" << std::endl;
-    while(!defaultUninitializedVariableCache.empty())
+    while(!context.defaultUninitializedVariableCache.empty())
     {
-      auto iter = defaultUninitializedVariableCache.begin();
-      defaultVariables.erase(iter->first);
-      defaultUninitializedVariableCache.erase(iter);
+      auto iter = context.defaultUninitializedVariableCache.begin();
+      context.defaultVariables.erase(iter->first);
+      context.defaultUninitializedVariableCache.erase(iter);
     }
   }
 }
 
-static void evaluate(std::string expression, ExpressionParser& expressionParser, bool verbose = true)
+static bool isBlank(std::string_view expression)
 {
   constexpr char kWhitespaceCharacters[] = " \t\v\n\r\f";
-  bool end                               = false;
-  while(!end && expression.find_first_not_of(kWhitespaceCharacters) != std::string::npos)
+  return expression.find_first_not_of(kWhitespaceCharacters) == std::string_view::npos;
+}
+
+static void evaluate(const CompiledExpression& compiledExpression, bool verbose, ResultCacheEntry* entry = nullptr)
+{
+  static ValueArena arena;
+  for(std::size_t i = 0u; i < compiledExpression.GetStatementCount(); i++)
+  {
+    const ValueArena::Scope arenaScope(arena);
+    CompiledExpression::TemporaryCollection temporaries;
+    IValueToken* result;
+    {
+      const TraceSpan span("evaluate", "statement");
+      result = compiledExpression.Evaluate(i, temporaries);
+    }
+
+    handleResult(result, verbose);
+    if(entry != nullptr)
+    {
+      entry->push_back(copyResult(result));
+    }
+  }
+}
+
+// Replays the memoized results of a pure expression, or evaluates and memoizes them. Any other expression may assign or remove variables, so it retires
+// the results computed so far.
+static void evaluate(std::string_view expression, const CompiledExpression& compiledExpression, bool verbose)
+{
+  auto& context = currentContext();
+  if(!compiledExpression.IsPure())
+  {
+    context.variableGeneration++;
+  }
+
+  if(!compiledExpression.IsPure() || context.resultCache.GetCapacity() == 0u)
+  {
+    evaluate(compiledExpression, verbose);
+    return;
+  }
+
+  const auto key    = makeResultCacheKey(expression);
+  const auto cached = context.resultCache.Find(key);
+  if(cached != nullptr)
+  {
+    for(const auto& i : *cached)
+    {
+      handleResult(i.get(), verbose);
+    }
+
+    return;
+  }
+
+  ResultCacheEntry entry;
+  evaluate(compiledExpression, verbose, &entry);
+  context.resultCache.Insert(key, std::move(entry));
+}
+
+static void evaluate(std::string_view expression, ExpressionParser& expressionParser, bool verbose = true)
+{
+  if(isBlank(expression))
   {
-    const auto result = expressionParser.Evaluate(expression);
-    handleResult(result->As<const DefaultValueType*>(), verbose);
+    return;
+  }
+
+  const TraceSpan span("evaluate", "line", expression);
+  synchronizeConstants();
+  const auto compiledExpression = compileCached(expression);
+  if(compiledExpression != nullptr)
+  {
+    evaluate(expression, *compiledExpression, verbose);
+    return;
+  }
+
+  currentContext().variableGeneration++;
+  std::string remaining(expression);
+  bool end = false;
+  while(!end && !isBlank(remaining))
+  {
+    IValueToken* result;
+    {
+      const TraceSpan parseSpan("parse", "parse and evaluate");
+      result = expressionParser.Evaluate(remaining);
+    }
+
+    handleResult(result, verbose);
     if(!(end = expressionParser.GetCurrent() != ';'))
     {
-      expression = (expressionParser.GetRemaining() + 1u);
+      remaining = (expressionParser.GetRemaining() + 1u);
+    }
+  }
+}
+
+static void evaluateRecords(std::FILE* file,
+                            const std::vector<std::string>& bindings,
+                            const std::vector<std::string>& exprs,
+                            ExpressionParser& expressionParser)
+{
+  auto& context      = currentContext();
+  const bool native  = context.options.engine == "f64";
+  const auto& assign = context.defaultBinaryOperatorCallbacks.at("=");
+
+  std::vector<IValueToken*> variables;
+  for(const auto& i : bindings)
+  {
+    const auto iter = context.defaultVariables.find(i);
+    variables.push_back(iter != context.defaultVariables.end() ? iter->second : context.defaultUnknownIdentifierCallback(i));
+  }
+
+  while(true)
+  {
+    for(std::size_t i = 0u; i < variables.size(); i++)
+    {
+      std::unique_ptr<IValueToken> value;
+      {
+        const TraceSpan span("input", "read");
+        value.reset(readBinaryValue(file, context.options.ifmt, native));
+      }
+
+      if(value == nullptr)
+      {
+        if(i != 0u)
+        {
+          throw std::runtime_error("Truncated binary record");
+        }
+
+        return;
+      }
+
+      assign(variables[i], value.get());
+    }
+
+    context.variableGeneration++;
+
+    for(const auto& expr : exprs)
+    {
+      evaluate(expr, expressionParser);
+    }
+  }
+}
+
+static void evaluateParallel(LineReader& reader, ExpressionParser& expressionParser, bool verbose)
+{
+  auto& context = currentContext();
+  BatchEvaluator batchEvaluator(context, context.options.threads, [verbose](const IValueToken* value) { handleResult(value, verbose); });
+
+  std::string_view input;
+  while(reader.Next(input))
+  {
+    if(isBlank(input))
+    {
+      continue;
+    }
+
+    const auto compiledExpression = compileCached(input);
+    if(compiledExpression != nullptr && compiledExpression->IsParallelSafe())
+    {
+      batchEvaluator.Submit(compiledExpression, input);
+      continue;
+    }
+
+    batchEvaluator.Drain();
+    if(compiledExpression != nullptr)
+    {
+      evaluate(input, *compiledExpression, verbose);
+    }
+    else
+    {
+      evaluate(input, expressionParser, verbose);
     }
   }
+
+  batchEvaluator.Drain();
 }
 
 void list(const std::string& searchPattern)
 {
+  const auto& context = currentContext();
   const std::regex regex(searchPattern);
   bool isPrevEmptyLine = true;
 
   std::cerr << "Unary operators" << std::endl;
-  for(const auto& i : unaryOperatorInfoMap)
+  for(const auto& i : context.unaryOperatorInfoMap)
   {
     const auto& entry = std::get<0u>(i);
     if(entry == nullptr)
@@ -211,7 +452,7 @@ void list(const std::string& searchPattern)
 
   isPrevEmptyLine = true;
   std::cerr << "Binary operators" << std::endl;
-  for(const auto& i : binaryOperatorInfoMap)
+  for(const auto& i : context.binaryOperatorInfoMap)
   {
     const auto& entry = std::get<0u>(i);
     if(entry == nullptr)
@@ -241,7 +482,7 @@ void list(const std::string& searchPattern)
 
   isPrevEmptyLine = true;
   std::cerr << "Functions" << std::endl;
-  for(const auto& i : functionInfoMap)
+  for(const auto& i : context.functionInfoMap)
   {
     const auto& entry = std::get<0u>(i);
     if(entry == nullptr)
@@ -271,10 +512,10 @@ void list(const std::string& searchPattern)
 
   isPrevEmptyLine = true;
   std::cerr << "Variables" << std::endl;
-  for(const auto& i : variableInfoMap)
+  for(const auto& i : context.variableInfoMap)
   {
-    const auto& entry = std::get<0u>(i);
-    if(entry == nullptr)
+    const auto& identifier = std::get<0u>(i);
+    if(identifier.empty())
     {
       if(!isPrevEmptyLine)
       {
@@ -285,7 +526,6 @@ void list(const std::string& searchPattern)
       continue;
     }
 
-    const auto& identifier  = entry->GetIdentifier();
     const auto& title       = std::get<1u>(i);
     const auto& description = std::get<2u>(i);
     if(std::regex_match(identifier.begin(), identifier.end(), regex) || std::regex_match(title.begin(), title.end(), regex) ||
@@ -299,16 +539,28 @@ void list(const std::string& searchPattern)
 
 static void printOptions()
 {
+  const auto& context = currentContext();
   std::cerr << "Options" << std::endl;
-  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Precision" % options.precision) << std::endl;
-  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Rounding mode" % rmodeNameMap.at(options.roundingMode)) << std::endl;
-  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Output precision" % options.digits) << std::endl;
-  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Output base" % options.output_base) << std::endl;
-  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Input base" % options.input_base) << std::endl;
-  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Juxtaposition precedence" % options.jpo_precedence) << std::endl;
-  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Variable names" % options.vnames) << std::endl;
-  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Date output format" % options.date_ofmt) << std::endl;
-  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Seed" % options.seed) << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Precision" % context.options.precision) << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Rounding mode" % rmodeNameMap.at(context.options.roundingMode)) << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Output precision" % context.options.digits) << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Output base" % context.options.output_base) << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Input base" % context.options.input_base) << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Juxtaposition precedence" % context.options.jpo_precedence) << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Variable names" % context.options.vnames) << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Date output format" % context.options.date_ofmt) << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Seed" % context.options.seed) << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Expression cache size" % context.options.cache_size) << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Compiled evaluation" % context.options.compile) << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Result cache size" % context.options.memo_size) << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Threads" % context.options.threads) << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Aggregate threads" % context.options.agg_threads) << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Engine" % context.options.engine) << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Output format" % context.options.ofmt) << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Input format" % context.options.ifmt) << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Input bindings" % context.options.bind) << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Result history size" % context.options.history) << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Result history file" % context.options.history_file) << std::endl;
   std::cerr << std::endl;
 }
 
@@ -316,12 +568,17 @@ static void printVersion() { std::cout << (boost::format("%1% v%2%") % PROJECT_N
 
 static void printUsage(const boost::program_options::options_description& desc)
 {
-  std::cerr << (boost::format("%1% -[xprnbBjdzZilvVh] expr...") % PROJECT_EXECUTABLE) << std::endl;
+  std::cerr << (boost::format("%1% -[xprnbBjdzZcmtHeilvVh] expr...") % PROJECT_EXECUTABLE) << std::endl;
   std::cerr << desc << std::endl;
 }
 
 int main(int argc, char* argv[])
 {
+  KalkContext context;
+  const KalkContext::Scope contextScope(context);
+  auto& options = context.options;
+  std::string traceFile;
+
   std::vector<std::string> envs;
   resolveEnvironmentVariables(envs);
 
@@ -331,15 +588,27 @@ int main(int argc, char* argv[])
   namedEnvDescs.add_options()("KALK_DIGITS", boost::program_options::value<int>(&options.digits)->default_value(defaultOptions.digits));
   namedEnvDescs.add_options()("KALK_OBASE", boost::program_options::value<int>(&options.output_base));
   namedEnvDescs.add_options()("KALK_IBASE", boost::program_options::value<int>(&options.input_base));
-  namedEnvDescs.add_options()("KALK_BASE", boost::program_options::value<int>()->default_value(defaultOptions.output_base)->notifier([](int value) {
+  namedEnvDescs.add_options()("KALK_BASE", boost::program_options::value<int>()->default_value(defaultOptions.output_base)->notifier([&options](int value) {
     options.output_base = value;
     options.input_base  = value;
   }));
-  namedEnvDescs.add_options()("KALK_JUXTA", boost::program_options::value<int>()->default_value(defaultOptions.jpo_precedence)->notifier([](int value) {
+  namedEnvDescs.add_options()("KALK_JUXTA", boost::program_options::value<int>()->default_value(defaultOptions.jpo_precedence)->notifier([&options](int value) {
     options.jpo_precedence = Math::Sign(value);
   }));
   namedEnvDescs.add_options()("KALK_VNAMES", boost::program_options::value<bool>(&options.vnames)->default_value(defaultOptions.vnames));
   namedEnvDescs.add_options()("KALK_DATE_OFMT", boost::program_options::value<std::string>(&options.date_ofmt)->default_value(defaultOptions.date_ofmt));
+  namedEnvDescs.add_options()("KALK_CACHE", boost::program_options::value<std::size_t>(&options.cache_size)->default_value(defaultOptions.cache_size));
+  namedEnvDescs.add_options()("KALK_COMPILE", boost::program_options::value<bool>(&options.compile)->default_value(defaultOptions.compile));
+  namedEnvDescs.add_options()("KALK_MEMO", boost::program_options::value<std::size_t>(&options.memo_size)->default_value(defaultOptions.memo_size));
+  namedEnvDescs.add_options()("KALK_THREADS", boost::program_options::value<unsigned int>(&options.threads)->default_value(defaultOptions.threads));
+  namedEnvDescs.add_options()("KALK_AGG_THREADS", boost::program_options::value<unsigned int>(&options.agg_threads)->default_value(defaultOptions.agg_threads));
+  namedEnvDescs.add_options()("KALK_HISTORY", boost::program_options::value<std::size_t>(&options.history)->default_value(defaultOptions.history));
+  namedEnvDescs.add_options()("KALK_HISTORY_FILE",
+                              boost::program_options::value<std::string>(&options.history_file)->default_value(defaultOptions.history_file));
+  namedEnvDescs.add_options()("KALK_OFMT", boost::program_options::value<std::string>(&options.ofmt)->default_value(defaultOptions.ofmt));
+  namedEnvDescs.add_options()("KALK_IFMT", boost::program_options::value<std::string>(&options.ifmt)->default_value(defaultOptions.ifmt));
+  namedEnvDescs.add_options()("KALK_BIND", boost::program_options::value<std::string>(&options.bind)->default_value(defaultOptions.bind));
+  namedEnvDescs.add_options()("KALK_ENGINE", boost::program_options::value<std::string>(&options.engine)->default_value(defaultOptions.engine));
   namedEnvDescs.add_options()("KALK_INTERACTIVE", boost::program_options::value<bool>(&options.interactive)->default_value(defaultOptions.interactive));
   namedEnvDescs.add_options()("KALK_VERBOSE", boost::program_options::value<std::string>()->default_value(""));
 
@@ -359,20 +628,38 @@ int main(int argc, char* argv[])
   namedArgDescs.add_options()("obase,b", boost::program_options::value<int>(&options.output_base), "Set output base");
   namedArgDescs.add_options()("ibase,B", boost::program_options::value<int>(&options.input_base), "Set input base");
   namedArgDescs.add_options()("base",
-                              boost::program_options::value<int>()->notifier([](int value) { options.input_base = options.output_base = value; }),
+                              boost::program_options::value<int>()->notifier([&options](int value) { options.input_base = options.output_base = value; }),
                               "Set output and input base");
   namedArgDescs.add_options()("juxta,j",
-                              boost::program_options::value<int>()->notifier([](int value) { options.jpo_precedence = Math::Sign(value); }),
+                              boost::program_options::value<int>()->notifier([&options](int value) { options.jpo_precedence = Math::Sign(value); }),
                               "Set juxtaposition operator precedence (-1, 0, 1)");
   namedArgDescs.add_options()("vnames", boost::program_options::value<bool>(&options.vnames)->implicit_value(true), "Print variable names instead of values");
   namedArgDescs.add_options()("date_ofmt,d", boost::program_options::value<std::string>(&options.date_ofmt), "Set date output format");
   namedArgDescs.add_options()("seed,z", boost::program_options::value<unsigned int>(&options.seed), "Set random seed (number)");
   namedArgDescs.add_options()("seedstr,Z",
-                              boost::program_options::value<std::string>()->notifier([](std::string value) {
+                              boost::program_options::value<std::string>()->notifier([&options](std::string value) {
                                 std::hash<std::string> hasher;
                                 options.seed = value.empty() ? defaultOptions.seed : static_cast<unsigned int>(hasher(value));
                               }),
                               "Set random seed (string)");
+  namedArgDescs.add_options()("cache,c", boost::program_options::value<std::size_t>(&options.cache_size), "Set compiled expression cache size (0 disables)");
+  namedArgDescs.add_options()("compile",
+                              boost::program_options::value<bool>(&options.compile)->implicit_value(true),
+                              "Evaluate through compiled programs (0 evaluates every line with the expression parser)");
+  namedArgDescs.add_options()("memo,m", boost::program_options::value<std::size_t>(&options.memo_size), "Set pure expression result cache size (0 disables)");
+  namedArgDescs.add_options()("threads,t",
+                              boost::program_options::value<unsigned int>(&options.threads),
+                              "Set number of worker threads for piped input (0 = hardware concurrency)");
+  namedArgDescs.add_options()("agg_threads",
+                              boost::program_options::value<unsigned int>(&options.agg_threads),
+                              "Set number of threads for large aggregates, vector operations and series (0 = hardware concurrency)");
+  namedArgDescs.add_options()("history,H", boost::program_options::value<std::size_t>(&options.history), "Set number of retained results (0 = unlimited)");
+  namedArgDescs.add_options()("history_file", boost::program_options::value<std::string>(&options.history_file), "Spill results evicted from history to file");
+  namedArgDescs.add_options()("ofmt", boost::program_options::value<std::string>(&options.ofmt), "Set result output format (text, f64, mpfr)");
+  namedArgDescs.add_options()("ifmt", boost::program_options::value<std::string>(&options.ifmt), "Set piped input format (text, f64, mpfr)");
+  namedArgDescs.add_options()("bind", boost::program_options::value<std::string>(&options.bind), "Bind binary input records to variables (comma separated)");
+  namedArgDescs.add_options()("trace", boost::program_options::value<std::string>(&traceFile), "Write a Chrome trace of evaluation phases to file");
+  namedArgDescs.add_options()("engine,e", boost::program_options::value<std::string>(&options.engine), "Set evaluation engine (mpfr, f64)");
   namedArgDescs.add_options()("interactive,i", boost::program_options::value<bool>(&options.interactive)->implicit_value(true), "Enable interactive mode");
   namedArgDescs.add_options()("list,l", boost::program_options::value<std::string>()->implicit_value(".*"), "List available operators/functions/variables");
   namedArgDescs.add_options()("verbose,v", boost::program_options::value<std::string>()->default_value("")->implicit_value("op"), "Enable verbose mode");
@@ -407,8 +694,47 @@ int main(int argc, char* argv[])
     std::exit(EXIT_FAILURE);
   }
 
-  mpfr::mpreal::set_default_prec(options.precision);
-  mpfr::mpreal::set_default_rnd(options.roundingMode);
+  if(options.engine != "mpfr" && options.engine != "f64")
+  {
+    std::cerr << (boost::format("*** Error: Unknown engine: %1% (mpfr, f64)") % options.engine) << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+
+  for(const auto& i : {options.ofmt, options.ifmt})
+  {
+    if(i != "text" && !isBinaryFormat(i))
+    {
+      std::cerr << (boost::format("*** Error: Unknown format: %1% (text, f64, mpfr)") % i) << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+  }
+
+  context.ApplyPrecision();
+  context.expressionCache.SetCapacity(options.cache_size);
+  context.resultCache.SetCapacity(options.memo_size);
+  context.results.SetCapacity(options.history);
+  if(!options.history_file.empty())
+  {
+    try
+    {
+      context.results.SetSpillPath(options.history_file);
+    }
+    catch(const std::exception& e)
+    {
+      std::cerr << "*** Error: " << e.what() << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+  }
+
+  if(options.threads == 0u)
+  {
+    options.threads = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+
+  if(options.agg_threads == 0u)
+  {
+    options.agg_threads = std::max(std::thread::hardware_concurrency(), 1u);
+  }
 
   auto dateFacet = new boost::posix_time::time_facet(options.date_ofmt.c_str());
   std::cout.imbue(std::locale(std::cout.getloc(), dateFacet));
@@ -417,17 +743,44 @@ int main(int argc, char* argv[])
                               argVariableMap["verbose"].as<const std::string&>().find_first_of("oO") != std::string::npos;
   const bool verbosePipe = envVariableMap["KALK_VERBOSE"].as<const std::string&>().find_first_of("pP") != std::string::npos ||
                            argVariableMap["verbose"].as<const std::string&>().find_first_of("pP") != std::string::npos;
+  const bool verboseCache = envVariableMap["KALK_VERBOSE"].as<const std::string&>().find_first_of("cC") != std::string::npos ||
+                            argVariableMap["verbose"].as<const std::string&>().find_first_of("cC") != std::string::npos;
+  const bool verboseAllocations = envVariableMap["KALK_VERBOSE"].as<const std::string&>().find_first_of("aA") != std::string::npos ||
+                                  argVariableMap["verbose"].as<const std::string&>().find_first_of("aA") != std::string::npos;
+  const bool verboseStatistics = envVariableMap["KALK_VERBOSE"].as<const std::string&>().find_first_of("sS") != std::string::npos ||
+                                 argVariableMap["verbose"].as<const std::string&>().find_first_of("sS") != std::string::npos;
 
   if(verboseOptions)
   {
     printOptions();
   }
 
+  if(!traceFile.empty())
+  {
+    try
+    {
+      openTrace(traceFile);
+    }
+    catch(const std::exception& e)
+    {
+      std::cerr << "*** Error: " << e.what() << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+  }
+
+  context.callStatistics.SetEnabled(verboseStatistics);
   ExpressionParser expressionParser;
-  InitDefaultExpressionParser(expressionParser);
+  if(options.engine == "f64")
+  {
+    InitNativeExpressionParser(expressionParser, context);
+  }
+  else
+  {
+    InitDefaultExpressionParser(expressionParser, context);
+  }
 
   CommandParser commandParser;
-  InitCommandParser(commandParser);
+  InitCommandParser(commandParser, context);
 
   if(argVariableMap.count("list") > 0u)
   {
@@ -437,14 +790,39 @@ int main(int argc, char* argv[])
 
   std::unique_ptr<FILE, decltype(&std::fclose)> file_stdin(nullptr, &std::fclose);
   bool hasPipedData = std::cin.rdbuf()->in_avail() != -1 && isatty(fileno(stdin)) == 0;
-  if(hasPipedData)
+  const bool hasRecordInput = hasPipedData && isBinaryFormat(options.ifmt);
+  if(hasRecordInput)
   {
-    std::string input;
-    while(std::getline(std::cin, input))
+    std::vector<std::string> bindings;
+    boost::split(bindings, options.bind, boost::is_any_of(","), boost::token_compress_on);
+    bindings.erase(std::remove(bindings.begin(), bindings.end(), std::string()), bindings.end());
+    if(bindings.empty() || argVariableMap.count("expr") == 0u)
     {
-      evaluate(input, expressionParser, verbosePipe);
+      std::cerr << "*** Error: Binary input requires bound variables and an expression" << std::endl;
+      std::exit(EXIT_FAILURE);
     }
 
+    evaluateRecords(stdin, bindings, argVariableMap["expr"].as<const std::vector<std::string>&>(), expressionParser);
+  }
+  else if(hasPipedData)
+  {
+    LineReader reader(fileno(stdin));
+    if(options.threads > 1u)
+    {
+      evaluateParallel(reader, expressionParser, verbosePipe);
+    }
+    else
+    {
+      std::string_view input;
+      while(reader.Next(input))
+      {
+        evaluate(input, expressionParser, verbosePipe);
+      }
+    }
+  }
+
+  if(hasPipedData)
+  {
     if(options.interactive)
     {
       const char* ttyFileName = ttyname(fileno(stdout));
@@ -471,9 +849,9 @@ int main(int argc, char* argv[])
     std::exit(EXIT_FAILURE);
   }
 
-  if(argVariableMap.count("expr") > 0u)
+  if(argVariableMap.count("expr") > 0u && !hasRecordInput)
   {
-    results.clear();
+    context.results.Clear();
 
     const auto& exprs = argVariableMap["expr"].as<const std::vector<std::string>&>();
     for(auto& expr : exprs)
@@ -484,10 +862,10 @@ int main(int argc, char* argv[])
 
   if(options.interactive)
   {
-    results.clear();
+    context.results.Clear();
 
     char* tmpInput;
-    while(!quit && (tmpInput = readline("> ")) != nullptr)
+    while(!context.quit && (tmpInput = readline("> ")) != nullptr)
     {
       auto tmpPtr       = std::unique_ptr<char, decltype(&std::free)>(tmpInput, &std::free);
       std::string input = tmpInput;
@@ -540,5 +918,21 @@ int main(int argc, char* argv[])
     }
   }
 
+  if(verboseCache)
+  {
+    printCacheStatistics();
+    printResultCacheStatistics();
+  }
+
+  if(verboseAllocations)
+  {
+    printAllocationStatistics();
+  }
+
+  if(verboseStatistics)
+  {
+    printCallStatistics();
+  }
+
   std::exit(EXIT_SUCCESS);
 }
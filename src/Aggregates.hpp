@@ -0,0 +1,100 @@
+#ifndef __AGGREGATES_HPP__
+#define __AGGREGATES_HPP__
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+// Value at position index of the sorted sequence. Partially reorders values.
+template<class T>
+T selectAt(std::vector<T>& values, std::size_t index)
+{
+  std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+  return values[index];
+}
+
+// Mean of the values at positions index - 1 and index of the sorted sequence. Partially reorders values.
+template<class T>
+T selectMidpoint(std::vector<T>& values, std::size_t index)
+{
+  const T upper = selectAt(values, index);
+  if(index == 0u)
+  {
+    return upper;
+  }
+
+  const T lower = *std::max_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index));
+  return (lower + upper) / 2;
+}
+
+// Median of the count values at positions begin through begin + count - 1 of the sorted sequence. Partially reorders values.
+template<class T>
+T selectMedian(std::vector<T>& values, std::size_t begin, std::size_t count)
+{
+  const std::size_t middle = begin + count / 2u;
+  return count % 2u == 0u ? selectMidpoint(values, middle) : selectAt(values, middle);
+}
+
+// Most frequent value, the smallest one on ties.
+template<class T, class THash = std::hash<T>>
+T selectMode(const std::vector<T>& values)
+{
+  std::unordered_map<T, std::size_t, THash> counts;
+  counts.reserve(values.size());
+  for(const auto& i : values)
+  {
+    counts[i]++;
+  }
+
+  auto result = counts.cbegin();
+  for(auto i = counts.cbegin(); i != counts.cend(); i++)
+  {
+    if(i->second > result->second || (i->second == result->second && i->first < result->first))
+    {
+      result = i;
+    }
+  }
+
+  return result->first;
+}
+
+// Single-pass mean and variance (Welford), mergeable across partial results (Chan et al.).
+template<class T>
+class RunningVariance
+{
+  public:
+  std::size_t GetCount() const { return m_Count; }
+  const T& GetMean() const { return m_Mean; }
+  T GetVariance() const { return m_Squares / static_cast<T>(m_Count); }
+
+  void Push(const T& value)
+  {
+    m_Count++;
+    const T delta = value - m_Mean;
+    m_Mean += delta / static_cast<T>(m_Count);
+    m_Squares += delta * (value - m_Mean);
+  }
+
+  void Merge(const RunningVariance& other)
+  {
+    if(other.m_Count == 0u)
+    {
+      return;
+    }
+
+    const auto count = m_Count + other.m_Count;
+    const T delta    = other.m_Mean - m_Mean;
+    m_Mean += delta * static_cast<T>(other.m_Count) / static_cast<T>(count);
+    m_Squares += other.m_Squares + delta * delta * static_cast<T>(m_Count) * static_cast<T>(other.m_Count) / static_cast<T>(count);
+    m_Count = count;
+  }
+
+  private:
+  std::size_t m_Count = 0u;
+  T m_Mean            = 0;
+  T m_Squares         = 0;
+};
+
+#endif // __AGGREGATES_HPP__
@@ -0,0 +1,170 @@
+#include "BatchEvaluator.hpp"
+#include "Trace.hpp"
+#include "ValueArena.hpp"
+#include "WorkerScope.hpp"
+
+BatchEvaluator::BatchEvaluator(KalkContext& context, std::size_t threadCount, const ResultCallback& callback)
+    : m_Context(context)
+    , m_Callback(callback)
+    , m_WindowSize(threadCount * 64u)
+{
+  for(std::size_t i = 0u; i < threadCount; i++)
+  {
+    m_Threads.emplace_back(&BatchEvaluator::Run, this);
+  }
+}
+
+BatchEvaluator::~BatchEvaluator()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Stop = true;
+    m_Queue.clear();
+  }
+
+  m_QueueCondition.notify_all();
+  for(auto& i : m_Threads)
+  {
+    i.join();
+  }
+}
+
+void BatchEvaluator::Submit(std::shared_ptr<const CompiledExpression> expression, std::string_view source)
+{
+  auto job        = std::make_unique<Job>();
+  job->expression = std::move(expression);
+
+  if(job->expression->IsPure() && m_Context.resultCache.GetCapacity() > 0u)
+  {
+    auto key          = makeResultCacheKey(source);
+    const auto cached = m_Context.resultCache.Find(key);
+    if(cached != nullptr)
+    {
+      job->cached = *cached;
+      for(const auto& i : job->cached)
+      {
+        job->values.push_back(i.get());
+      }
+
+      job->done = true;
+      m_Window.push_back(std::move(job));
+      Flush(false);
+      return;
+    }
+
+    job->memoKey = std::move(key);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Queue.push_back(job.get());
+  }
+
+  m_Window.push_back(std::move(job));
+  m_QueueCondition.notify_one();
+
+  Flush(m_Window.size() >= m_WindowSize);
+}
+
+void BatchEvaluator::Drain()
+{
+  while(!m_Window.empty())
+  {
+    Flush(true);
+  }
+}
+
+void BatchEvaluator::Run()
+{
+  const KalkContext::Scope scope(m_Context);
+  const WorkerScope workerScope;
+  ValueArena arena;
+
+  while(true)
+  {
+    Job* job;
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_QueueCondition.wait(lock, [this]() { return m_Stop || !m_Queue.empty(); });
+      if(m_Stop)
+      {
+        return;
+      }
+
+      job = m_Queue.front();
+      m_Queue.pop_front();
+    }
+
+    try
+    {
+      const ValueArena::Scope arenaScope(arena);
+      for(std::size_t i = 0u; i < job->expression->GetStatementCount(); i++)
+      {
+        const TraceSpan span("evaluate", "statement");
+        auto value = job->expression->Evaluate(i, job->temporaries);
+        if(arena.Owns(value))
+        {
+          job->temporaries.push_back(std::make_unique<DefaultValueType>(*value->As<DefaultValueType*>()));
+          value = job->temporaries.back().get();
+        }
+
+        job->values.push_back(value);
+      }
+    }
+    catch(...)
+    {
+      job->error = std::current_exception();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      job->done = true;
+    }
+
+    m_DoneCondition.notify_all();
+  }
+}
+
+void BatchEvaluator::Flush(bool wait)
+{
+  while(!m_Window.empty())
+  {
+    auto& job = m_Window.front();
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      if(wait)
+      {
+        m_DoneCondition.wait(lock, [&job]() { return job->done; });
+      }
+      else if(!job->done)
+      {
+        return;
+      }
+    }
+
+    auto current = std::move(job);
+    m_Window.pop_front();
+    wait = false;
+
+    if(current->error != nullptr)
+    {
+      std::rethrow_exception(current->error);
+    }
+
+    for(const auto& i : current->values)
+    {
+      m_Callback(i);
+    }
+
+    if(current->memoKey.has_value())
+    {
+      ResultCacheEntry entry;
+      for(const auto& i : current->values)
+      {
+        entry.push_back(copyResult(i));
+      }
+
+      m_Context.resultCache.Insert(*current->memoKey, std::move(entry));
+    }
+  }
+}
@@ -0,0 +1,61 @@
+#ifndef __BATCHEVALUATOR_HPP__
+#define __BATCHEVALUATOR_HPP__
+
+#include "CompiledExpression.hpp"
+#include "KalkContext.hpp"
+#include "Setup.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+class BatchEvaluator
+{
+  public:
+  using ResultCallback = std::function<void(const IValueToken*)>;
+
+  BatchEvaluator(KalkContext& context, std::size_t threadCount, const ResultCallback& callback);
+  ~BatchEvaluator();
+
+  BatchEvaluator(const BatchEvaluator&)            = delete;
+  BatchEvaluator& operator=(const BatchEvaluator&) = delete;
+
+  void Submit(std::shared_ptr<const CompiledExpression> expression, std::string_view source);
+  void Drain();
+
+  private:
+  struct Job
+  {
+    std::shared_ptr<const CompiledExpression> expression;
+    CompiledExpression::TemporaryCollection temporaries;
+    std::vector<const IValueToken*> values;
+    ResultCacheEntry cached;
+    std::optional<ResultCacheKey> memoKey;
+    std::exception_ptr error;
+    bool done = false;
+  };
+
+  void Run();
+  void Flush(bool wait);
+
+  KalkContext& m_Context;
+  ResultCallback m_Callback;
+  std::size_t m_WindowSize;
+  std::deque<std::unique_ptr<Job>> m_Window;
+  std::deque<Job*> m_Queue;
+  std::mutex m_Mutex;
+  std::condition_variable m_QueueCondition;
+  std::condition_variable m_DoneCondition;
+  bool m_Stop = false;
+  std::vector<std::thread> m_Threads;
+};
+
+#endif // __BATCHEVALUATOR_HPP__
@@ -0,0 +1,132 @@
+#include "BinaryIO.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+
+#include <boost/format.hpp>
+
+static void writeBytes(std::FILE* file, const void* data, std::size_t size)
+{
+  if(std::fwrite(data, 1u, size, file) != size)
+  {
+    throw std::runtime_error(std::strerror(errno));
+  }
+}
+
+static bool readBytes(std::FILE* file, void* data, std::size_t size)
+{
+  const auto count = std::fread(data, 1u, size, file);
+  if(count == 0u && std::feof(file) != 0)
+  {
+    return false;
+  }
+  else if(count != size)
+  {
+    throw std::runtime_error("Truncated binary record");
+  }
+
+  return true;
+}
+
+static DefaultArithmeticType toExportValue(const IValueToken* value)
+{
+  const auto native = value->As<const NativeValueType*>();
+  if(native != nullptr && native->GetType() == typeid(NativeArithmeticType))
+  {
+    return DefaultArithmeticType(native->GetValue<NativeArithmeticType>(), std::numeric_limits<NativeArithmeticType>::digits);
+  }
+  else if(value->GetType() == typeid(DefaultArithmeticType))
+  {
+    return value->As<const DefaultValueType*>()->GetValue<DefaultArithmeticType>();
+  }
+  else if(value->GetType() == typeid(DefaultIntegerType))
+  {
+    const auto& integer = value->As<const DefaultValueType*>()->GetValue<DefaultIntegerType>();
+    const auto bits     = static_cast<mpfr_prec_t>(mpz_sizeinbase(integer.get_mpz_t(), 2));
+    return DefaultArithmeticType(integer.get_mpz_t(), std::max<mpfr_prec_t>(bits, MPFR_PREC_MIN));
+  }
+
+  throw std::runtime_error((boost::format("Binary output of non-numeric value: %1%") % value->ToString()).str());
+}
+
+bool isBinaryFormat(const std::string& format) { return format == "f64" || format == "mpfr"; }
+
+void writeBinaryValue(std::FILE* file, const IValueToken* value, const std::string& format)
+{
+  if(format == "f64")
+  {
+    const auto native = value->As<const NativeValueType*>();
+    const double result =
+        (native != nullptr && native->GetType() == typeid(NativeArithmeticType)) ? native->GetValue<NativeArithmeticType>() : toExportValue(value).toDouble();
+    writeBytes(file, &result, sizeof(result));
+    return;
+  }
+
+  auto exportValue = toExportValue(value);
+  char* buffer     = nullptr;
+  std::size_t size = 0u;
+  std::FILE* stream;
+  if((stream = open_memstream(&buffer, &size)) == nullptr)
+  {
+    throw std::runtime_error(std::strerror(errno));
+  }
+
+  const bool exported = mpfr_fpif_export(stream, exportValue.mpfr_ptr()) == 0;
+  std::fclose(stream);
+
+  const auto bufferPtr = std::unique_ptr<char, decltype(&std::free)>(buffer, &std::free);
+  if(!exported)
+  {
+    throw std::runtime_error("Could not export value: " + exportValue.toString());
+  }
+
+  const auto length = static_cast<std::uint32_t>(size);
+  writeBytes(file, &length, sizeof(length));
+  writeBytes(file, bufferPtr.get(), size);
+}
+
+IValueToken* readBinaryValue(std::FILE* file, const std::string& format, bool native)
+{
+  if(format == "f64")
+  {
+    double value;
+    if(!readBytes(file, &value, sizeof(value)))
+    {
+      return nullptr;
+    }
+
+    return native ? static_cast<IValueToken*>(new NativeValueType(value)) : new DefaultValueType(DefaultArithmeticType(value));
+  }
+
+  std::uint32_t length;
+  if(!readBytes(file, &length, sizeof(length)))
+  {
+    return nullptr;
+  }
+
+  std::string buffer(length, '\0');
+  if(length == 0u || !readBytes(file, buffer.data(), length))
+  {
+    throw std::runtime_error("Truncated binary record");
+  }
+
+  const auto stream = std::unique_ptr<std::FILE, decltype(&std::fclose)>(fmemopen(buffer.data(), length, "rb"), &std::fclose);
+  if(stream == nullptr)
+  {
+    throw std::runtime_error(std::strerror(errno));
+  }
+
+  DefaultArithmeticType value;
+  if(mpfr_fpif_import(value.mpfr_ptr(), stream.get()) != 0)
+  {
+    throw std::runtime_error("Could not import binary record");
+  }
+
+  return native ? static_cast<IValueToken*>(new NativeValueType(value.toDouble())) : new DefaultValueType(value);
+}
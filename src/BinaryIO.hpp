@@ -0,0 +1,13 @@
+#ifndef __BINARYIO_HPP__
+#define __BINARYIO_HPP__
+
+#include "Setup.hpp"
+
+#include <cstdio>
+#include <string>
+
+bool isBinaryFormat(const std::string& format);
+void writeBinaryValue(std::FILE* file, const IValueToken* value, const std::string& format);
+IValueToken* readBinaryValue(std::FILE* file, const std::string& format, bool native);
+
+#endif // __BINARYIO_HPP__
@@ -0,0 +1,75 @@
+#include "CallStatistics.hpp"
+#include "KalkContext.hpp"
+#include "ValueArena.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <boost/format.hpp>
+
+static std::size_t allocationCount() { return allocationCounters.heapAllocations + allocationCounters.arenaAllocations; }
+
+CallCounter::Sample::Sample(CallCounter& counter)
+    : m_Counter(counter)
+    , m_Start(TraceClock::now())
+    , m_Allocations(allocationCount())
+{}
+
+CallCounter::Sample::~Sample()
+{
+  const auto end     = TraceClock::now();
+  const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end - m_Start);
+  m_Counter.calls.fetch_add(1u, std::memory_order_relaxed);
+  m_Counter.nanoseconds.fetch_add(static_cast<std::uint64_t>(elapsed.count()), std::memory_order_relaxed);
+  m_Counter.allocations.fetch_add(allocationCount() - m_Allocations, std::memory_order_relaxed);
+  if(traceEnabled)
+  {
+    recordTraceEvent(m_Counter.kind, m_Counter.identifier, std::string_view(), m_Start, end);
+  }
+}
+
+void CallStatistics::Reset()
+{
+  for(auto& i : m_Counters)
+  {
+    i.calls       = 0u;
+    i.nanoseconds = 0u;
+    i.allocations = 0u;
+  }
+}
+
+void printCallStatistics()
+{
+  const auto& statistics = currentContext().callStatistics;
+  std::cerr << "Callback statistics" << std::endl;
+  if(!statistics.IsEnabled())
+  {
+    std::cerr << "  Disabled (Enable with -v s)" << std::endl << std::endl;
+    return;
+  }
+
+  std::vector<const CallCounter*> counters;
+  for(const auto& i : statistics.GetCounters())
+  {
+    if(i.calls > 0u)
+    {
+      counters.push_back(&i);
+    }
+  }
+
+  std::sort(counters.begin(), counters.end(), [](const CallCounter* a, const CallCounter* b) { return a->nanoseconds > b->nanoseconds; });
+
+  const auto format = boost::format("  %|1$-26|%|2$-14|%|3$-14|%|4$-14|%|5$|");
+  std::cerr << (boost::format(format) % "Callback" % "Calls" % "Time (ms)" % "Time/call (ns)" % "Allocations") << std::endl;
+  for(const auto i : counters)
+  {
+    const std::uint64_t calls       = i->calls;
+    const std::uint64_t nanoseconds = i->nanoseconds;
+    std::cerr << (boost::format(format) % (std::string(i->kind) + ' ' + i->identifier) % calls % (static_cast<double>(nanoseconds) / 1e6) %
+                  (nanoseconds / calls) % i->allocations.load())
+              << std::endl;
+  }
+
+  std::cerr << std::endl;
+}
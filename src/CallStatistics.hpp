@@ -0,0 +1,79 @@
+#ifndef __CALLSTATISTICS_HPP__
+#define __CALLSTATISTICS_HPP__
+
+#include "Trace.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <utility>
+
+// Calls, cumulative time and value allocations of one registered callback. Callbacks run on any evaluating thread, so the fields are atomic. Time and
+// allocations include nested callbacks running on the same thread, such as the body of a sum().
+struct CallCounter
+{
+  class Sample
+  {
+    public:
+    explicit Sample(CallCounter& counter);
+    ~Sample();
+
+    Sample(const Sample&)            = delete;
+    Sample& operator=(const Sample&) = delete;
+
+    private:
+    CallCounter& m_Counter;
+    TraceClock::time_point m_Start;
+    std::size_t m_Allocations;
+  };
+
+  CallCounter(const char* kind, std::string identifier)
+      : kind(kind)
+      , identifier(std::move(identifier))
+  {}
+
+  const char* kind;
+  std::string identifier;
+  std::atomic<std::uint64_t> calls {0u};
+  std::atomic<std::uint64_t> nanoseconds {0u};
+  std::atomic<std::uint64_t> allocations {0u};
+};
+
+// Whether counting is enabled is decided as each callback is registered. A callback registered while disabled is stored as is, so it costs nothing. Callbacks
+// are also wrapped while tracing, since each call is then recorded as a trace event.
+class CallStatistics
+{
+  public:
+  bool IsEnabled() const { return m_Enabled; }
+  void SetEnabled(bool value) { m_Enabled = value; }
+
+  const std::deque<CallCounter>& GetCounters() const { return m_Counters; }
+
+  template<class TCallback>
+  TCallback Instrument(const TCallback& callback, const char* kind, const std::string& identifier)
+  {
+    if(!m_Enabled && !traceEnabled)
+    {
+      return callback;
+    }
+
+    auto& counter = m_Counters.emplace_back(kind, identifier);
+    return [callback, &counter](auto&&... args) {
+      const CallCounter::Sample sample(counter);
+      return callback(std::forward<decltype(args)>(args)...);
+    };
+  }
+
+  void Reset();
+
+  private:
+  bool m_Enabled = false;
+  std::deque<CallCounter> m_Counters;
+};
+
+void printCallStatistics();
+
+#endif // __CALLSTATISTICS_HPP__
@@ -0,0 +1,210 @@
+#include "Combinatorics.hpp"
+#include "LruCache.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+// Farthest distance from the previous argument that is bridged with a range product rather than computed afresh.
+static constexpr unsigned long kFactorialStepLimit = 256u;
+
+// Precision of double counterparts.
+static constexpr mpfr_prec_t kDoublePrecision = std::numeric_limits<double>::digits;
+
+struct FactorialCache
+{
+  LruCache<unsigned long, mpz_class> values {16u};
+  unsigned long last = 0u;
+};
+
+// Product of lower + 1 through upper.
+static mpz_class rangeProduct(unsigned long lower, unsigned long upper)
+{
+  mpz_class result = 1;
+  for(unsigned long i = upper; i > lower; i--)
+  {
+    mpz_mul_ui(result.get_mpz_t(), result.get_mpz_t(), i);
+  }
+
+  return result;
+}
+
+const mpz_class& exactFactorial(unsigned long n)
+{
+  static thread_local FactorialCache cache;
+  const auto cached = cache.values.Find(n);
+  if(cached != nullptr)
+  {
+    cache.last = n;
+    return *cached;
+  }
+
+  mpz_class result;
+  const auto previous = cache.values.Find(cache.last);
+  if(previous != nullptr && n > cache.last && n - cache.last <= kFactorialStepLimit)
+  {
+    result = *previous * rangeProduct(cache.last, n);
+  }
+  else if(previous != nullptr && n < cache.last && cache.last - n <= kFactorialStepLimit)
+  {
+    mpz_divexact(result.get_mpz_t(), previous->get_mpz_t(), rangeProduct(n, cache.last).get_mpz_t());
+  }
+  else
+  {
+    mpz_fac_ui(result.get_mpz_t(), n);
+  }
+
+  cache.last = n;
+  return *cache.values.Insert(n, std::move(result));
+}
+
+mpz_class exactBinomial(const mpz_class& n, unsigned long k)
+{
+  mpz_class result;
+  const mpz_class rest = n - k;
+  if(sgn(n) >= 0 && sgn(rest) >= 0 && rest < k)
+  {
+    mpz_bin_ui(result.get_mpz_t(), n.get_mpz_t(), rest.get_ui());
+  }
+  else
+  {
+    mpz_bin_ui(result.get_mpz_t(), n.get_mpz_t(), k);
+  }
+
+  return result;
+}
+
+mpz_class exactMultinomial(const std::vector<unsigned long>& counts)
+{
+  mpz_class result = 1;
+  mpz_class term;
+  unsigned long total = 0u;
+  for(const auto i : counts)
+  {
+    if(total > std::numeric_limits<unsigned long>::max() - i)
+    {
+      throw std::range_error("Multinomial total out of range");
+    }
+
+    total += i;
+    mpz_bin_uiui(term.get_mpz_t(), total, i);
+    result *= term;
+  }
+
+  return result;
+}
+
+static bool isExactArgument(const mpfr::mpreal& value) { return mpfr::isint(value) && value >= 0 && value <= kExactFactorialLimit; }
+
+// Gamma(numerator) divided by the product of Gamma(denominators). When the gamma values themselves overflow, the quotient of positive arguments is taken in
+// log space instead.
+static mpfr::mpreal gammaQuotient(const mpfr::mpreal& numerator, const std::vector<mpfr::mpreal>& denominators)
+{
+  mpfr::mpreal result = mpfr::gamma(numerator);
+  for(const auto& i : denominators)
+  {
+    result /= mpfr::gamma(i);
+  }
+
+  if(mpfr::isfinite(result) || numerator <= 0 || std::any_of(denominators.cbegin(), denominators.cend(), [](const mpfr::mpreal& x) { return x <= 0; }))
+  {
+    return result;
+  }
+
+  mpfr::mpreal exponent = mpfr::lngamma(numerator);
+  for(const auto& i : denominators)
+  {
+    exponent -= mpfr::lngamma(i);
+  }
+
+  return mpfr::exp(exponent);
+}
+
+mpfr::mpreal factorial(const mpfr::mpreal& value)
+{
+  if(mpfr::isint(value) && value < 0)
+  {
+    throw std::range_error("Factorial of a negative integer");
+  }
+
+  if(isExactArgument(value))
+  {
+    return mpfr::mpreal(exactFactorial(value.toULong()).get_mpz_t());
+  }
+
+  return mpfr::gamma(value + 1);
+}
+
+mpfr::mpreal binomial(const mpfr::mpreal& n, const mpfr::mpreal& k)
+{
+  if(!mpfr::isint(n) || !mpfr::isint(k))
+  {
+    return gammaQuotient(n + 1, {k + 1, n - k + 1});
+  }
+
+  if(k < 0 || (n >= 0 && k > n))
+  {
+    return 0;
+  }
+
+  if(n < 0)
+  {
+    const auto result = binomial(k - n - 1, k);
+    return mpfr::isint(k / 2) ? result : -result;
+  }
+
+  const auto smaller = std::min(k, n - k);
+  if(!isExactArgument(smaller))
+  {
+    return gammaQuotient(n + 1, {k + 1, n - k + 1});
+  }
+
+  mpz_class exactN;
+  mpfr_get_z(exactN.get_mpz_t(), n.mpfr_srcptr(), MPFR_RNDN);
+  return mpfr::mpreal(exactBinomial(exactN, smaller.toULong()).get_mpz_t());
+}
+
+mpfr::mpreal multinomial(const std::vector<mpfr::mpreal>& counts)
+{
+  mpfr::mpreal total = 0;
+  for(const auto& i : counts)
+  {
+    total += i;
+  }
+
+  if(isExactArgument(total) && std::all_of(counts.cbegin(), counts.cend(), isExactArgument))
+  {
+    std::vector<unsigned long> exactCounts;
+    exactCounts.reserve(counts.size());
+    for(const auto& i : counts)
+    {
+      exactCounts.push_back(i.toULong());
+    }
+
+    return mpfr::mpreal(exactMultinomial(exactCounts).get_mpz_t());
+  }
+
+  std::vector<mpfr::mpreal> denominators;
+  denominators.reserve(counts.size());
+  for(const auto& i : counts)
+  {
+    denominators.push_back(i + 1);
+  }
+
+  return gammaQuotient(total + 1, denominators);
+}
+
+double binomial(double n, double k) { return binomial(mpfr::mpreal(n, kDoublePrecision), mpfr::mpreal(k, kDoublePrecision)).toDouble(); }
+
+double multinomial(const std::vector<double>& counts)
+{
+  std::vector<mpfr::mpreal> values;
+  values.reserve(counts.size());
+  for(const auto i : counts)
+  {
+    values.emplace_back(i, kDoublePrecision);
+  }
+
+  return multinomial(values).toDouble();
+}
@@ -0,0 +1,31 @@
+#ifndef __COMBINATORICS_HPP__
+#define __COMBINATORICS_HPP__
+
+#include <vector>
+
+#include <gmpxx.h>
+#include <mpreal.h>
+
+// Largest n whose n! (and n choose k, by the smaller of k and n - k) is computed exactly on the way to a floating point result. Beyond it the exact value
+// would cost far more than the precision it is rounded to, so the gamma function is used instead.
+constexpr unsigned long kExactFactorialLimit = 1ul << 16u;
+
+// Exact n!. Recent results are kept per thread, and a request near the previous one is derived from it by multiplying or dividing by the range product
+// in between, so stepping through consecutive arguments is cheap. The reference stays valid until the next call on the same thread.
+const mpz_class& exactFactorial(unsigned long n);
+// Exact n choose k, for any integer n (negative n by the usual extension).
+mpz_class exactBinomial(const mpz_class& n, unsigned long k);
+// Exact (k1 + k2 + ...)! / (k1! k2! ...), as a product of binomials.
+mpz_class exactMultinomial(const std::vector<unsigned long>& counts);
+
+// Floating point counterparts. Integer arguments within kExactFactorialLimit go through the exact functions and are rounded once. Other arguments go through
+// the gamma function, which also extends the factorial to non-integers.
+mpfr::mpreal factorial(const mpfr::mpreal& value);
+mpfr::mpreal binomial(const mpfr::mpreal& n, const mpfr::mpreal& k);
+mpfr::mpreal multinomial(const std::vector<mpfr::mpreal>& counts);
+
+// Double counterparts, computed by the functions above at double's precision, so integer arguments are exact up to the final rounding.
+double binomial(double n, double k);
+double multinomial(const std::vector<double>& counts);
+
+#endif // __COMBINATORICS_HPP__
@@ -1,19 +1,31 @@
+#include "KalkContext.hpp"
 #include "Setup.hpp"
 
 #include <cstdlib>
 #include <functional>
+#include <stdexcept>
 
 #include <readline/history.h>
 
 int Command_Prec(const std::vector<std::string>& args)
 {
+  auto& context = currentContext();
   if(args.size() == 0u)
   {
-    std::cout << options.precision << std::endl;
+    std::cout << context.options.precision << std::endl;
   }
   else
   {
-    options.precision = static_cast<mpfr_prec_t>(std::stol(args[0]));
+    const auto precision = static_cast<mpfr_prec_t>(std::stol(args[0]));
+    if(precision < MPFR_PREC_MIN || precision > MPFR_PREC_MAX)
+    {
+      throw std::domain_error("Precision out of range: " + args[0]);
+    }
+
+    const auto previousPrecision = context.options.precision;
+    context.options.precision    = precision;
+    context.ApplyPrecision();
+    refreshConstants(previousPrecision, context.options.roundingMode);
   }
 
   return 0;
@@ -21,13 +33,17 @@ int Command_Prec(const std::vector<std::string>& args)
 
 int Command_RMode(const std::vector<std::string>& args)
 {
+  auto& context = currentContext();
   if(args.size() == 0u)
   {
-    std::cout << options.roundingMode << std::endl;
+    std::cout << context.options.roundingMode << std::endl;
   }
   else
   {
-    options.roundingMode = strToRmode(args[0]);
+    const auto previousRoundingMode = context.options.roundingMode;
+    context.options.roundingMode    = strToRmode(args[0]);
+    context.ApplyPrecision();
+    refreshConstants(context.options.precision, previousRoundingMode);
   }
 
   return 0;
@@ -35,13 +51,14 @@ int Command_RMode(const std::vector<std::string>& args)
 
 int Command_Digits(const std::vector<std::string>& args)
 {
+  auto& context = currentContext();
   if(args.size() == 0u)
   {
-    std::cout << options.digits << std::endl;
+    std::cout << context.options.digits << std::endl;
   }
   else
   {
-    options.digits = std::stoi(args[0]);
+    context.options.digits = std::stoi(args[0]);
   }
 
   return 0;
@@ -49,13 +66,14 @@ int Command_Digits(const std::vector<std::string>& args)
 
 int Command_OBase(const std::vector<std::string>& args)
 {
+  auto& context = currentContext();
   if(args.size() == 0u)
   {
-    std::cout << options.output_base << std::endl;
+    std::cout << context.options.output_base << std::endl;
   }
   else
   {
-    options.output_base = std::stoi(args[0]);
+    context.options.output_base = std::stoi(args[0]);
   }
 
   return 0;
@@ -63,13 +81,14 @@ int Command_OBase(const std::vector<std::string>& args)
 
 int Command_IBase(const std::vector<std::string>& args)
 {
+  auto& context = currentContext();
   if(args.size() == 0u)
   {
-    std::cout << options.input_base << std::endl;
+    std::cout << context.options.input_base << std::endl;
   }
   else
   {
-    options.input_base = std::stoi(args[0]);
+    context.options.input_base = std::stoi(args[0]);
   }
 
   return 0;
@@ -77,18 +96,19 @@ int Command_IBase(const std::vector<std::string>& args)
 
 int Command_Base(const std::vector<std::string>& args)
 {
+  auto& context = currentContext();
   if(args.size() == 0u)
   {
-    std::cout << options.output_base << ", " << options.input_base << std::endl;
+    std::cout << context.options.output_base << ", " << context.options.input_base << std::endl;
   }
   else if(args.size() == 1u)
   {
-    options.input_base = options.output_base = std::stoi(args[0]);
+    context.options.input_base = context.options.output_base = std::stoi(args[0]);
   }
   else if(args.size() == 2u)
   {
-    options.output_base = std::stoi(args[0]);
-    options.input_base  = std::stoi(args[1]);
+    context.options.output_base = std::stoi(args[0]);
+    context.options.input_base  = std::stoi(args[1]);
   }
   else
   {
@@ -100,13 +120,14 @@ int Command_Base(const std::vector<std::string>& args)
 
 int Command_Jpo(const std::vector<std::string>& args)
 {
+  auto& context = currentContext();
   if(args.size() == 0u)
   {
-    std::cout << options.jpo_precedence << std::endl;
+    std::cout << context.options.jpo_precedence << std::endl;
   }
   else
   {
-    options.jpo_precedence = std::stoi(args[0]);
+    context.options.jpo_precedence = std::stoi(args[0]);
   }
 
   return 0;
@@ -114,13 +135,14 @@ int Command_Jpo(const std::vector<std::string>& args)
 
 int Command_Date_Ofmt(const std::vector<std::string>& args)
 {
+  auto& context = currentContext();
   if(args.size() == 0u)
   {
-    std::cout << options.date_ofmt << std::endl;
+    std::cout << context.options.date_ofmt << std::endl;
   }
   else
   {
-    options.date_ofmt = args[0];
+    context.options.date_ofmt = args[0];
   }
 
   return 0;
@@ -128,14 +150,15 @@ int Command_Date_Ofmt(const std::vector<std::string>& args)
 
 int Command_Seed(const std::vector<std::string>& args)
 {
+  auto& context = currentContext();
   if(args.size() == 0u)
   {
-    std::cout << options.seed << std::endl;
+    std::cout << context.options.seed << std::endl;
   }
   else
   {
-    options.seed = static_cast<unsigned int>(std::stoul(args[0]));
-    mpfr::random(options.seed == 0u ? static_cast<unsigned int>(std::time(nullptr)) : options.seed);
+    context.options.seed = static_cast<unsigned int>(std::stoul(args[0]));
+    mpfr::random(context.options.seed == 0u ? static_cast<unsigned int>(std::time(nullptr)) : context.options.seed);
   }
 
   return 0;
@@ -143,15 +166,16 @@ int Command_Seed(const std::vector<std::string>& args)
 
 int Command_SeedStr(const std::vector<std::string>& args)
 {
+  auto& context = currentContext();
   if(args.size() == 0u)
   {
-    std::cout << options.seed << std::endl;
+    std::cout << context.options.seed << std::endl;
   }
   else
   {
     std::hash<std::string> hasher;
-    options.seed = args[0].empty() ? defaultOptions.seed : static_cast<unsigned int>(hasher(args[0]));
-    mpfr::random(options.seed == 0u ? static_cast<unsigned int>(std::time(nullptr)) : options.seed);
+    context.options.seed = args[0].empty() ? defaultOptions.seed : static_cast<unsigned int>(hasher(args[0]));
+    mpfr::random(context.options.seed == 0u ? static_cast<unsigned int>(std::time(nullptr)) : context.options.seed);
   }
 
   return 0;
@@ -159,6 +183,7 @@ int Command_SeedStr(const std::vector<std::string>& args)
 
 int Command_Ans(const std::vector<std::string>& args)
 {
+  const auto& context = currentContext();
   if(args.size() == 0u)
   {
     auto value = ans();
@@ -168,14 +193,20 @@ int Command_Ans(const std::vector<std::string>& args)
   {
     if(args[0] == "*")
     {
-      for(auto iter = results.rbegin(); iter != results.rend(); iter++)
+      for(std::size_t i = context.results.GetSize(); i > 0u; i--)
       {
-        printValue(*iter);
+        const auto value = context.results.Get(i - 1u);
+        if(value == nullptr)
+        {
+          break;
+        }
+
+        printValue(*value);
       }
     }
     else if(args[0] == "#")
     {
-      std::cout << results.size() << std::endl;
+      std::cout << context.results.GetSize() << std::endl;
     }
     else
     {
@@ -188,6 +219,92 @@ int Command_Ans(const std::vector<std::string>& args)
   return 0;
 }
 
+int Command_Cache(const std::vector<std::string>& args)
+{
+  auto& context = currentContext();
+  if(args.size() == 0u)
+  {
+    printCacheStatistics();
+  }
+  else if(args[0] == "clear")
+  {
+    context.expressionCache.Clear();
+    context.expressionCache.ResetStatistics();
+  }
+  else
+  {
+    context.options.cache_size = static_cast<std::size_t>(std::stoul(args[0]));
+    context.expressionCache.SetCapacity(context.options.cache_size);
+  }
+
+  return 0;
+}
+
+int Command_Memo(const std::vector<std::string>& args)
+{
+  auto& context = currentContext();
+  if(args.size() == 0u)
+  {
+    printResultCacheStatistics();
+  }
+  else if(args[0] == "clear")
+  {
+    context.resultCache.Clear();
+    context.resultCache.ResetStatistics();
+  }
+  else
+  {
+    context.options.memo_size = static_cast<std::size_t>(std::stoul(args[0]));
+    context.resultCache.SetCapacity(context.options.memo_size);
+  }
+
+  return 0;
+}
+
+int Command_Stats(const std::vector<std::string>& args)
+{
+  auto& context = currentContext();
+  if(args.size() == 0u)
+  {
+    printCallStatistics();
+  }
+  else if(args[0] == "clear")
+  {
+    context.callStatistics.Reset();
+  }
+  else
+  {
+    throw std::domain_error("Invalid argument: " + args[0]);
+  }
+
+  return 0;
+}
+
+int Command_History(const std::vector<std::string>& args)
+{
+  auto& context = currentContext();
+  if(args.size() == 0u)
+  {
+    printHistoryStatistics();
+  }
+  else if(args[0] == "clear")
+  {
+    context.results.Clear();
+  }
+  else if(args[0] == "file")
+  {
+    context.options.history_file = (args.size() > 1u) ? args[1] : "";
+    context.results.SetSpillPath(context.options.history_file);
+  }
+  else
+  {
+    context.options.history = static_cast<std::size_t>(std::stoul(args[0]));
+    context.results.SetCapacity(context.options.history);
+  }
+
+  return 0;
+}
+
 int Command_List(const std::vector<std::string>& args)
 {
   std::string arg = (args.size() == 0u) ? ".*" : args[0];
@@ -198,6 +315,7 @@ int Command_List(const std::vector<std::string>& args)
 
 int Command_Clear(const std::vector<std::string>& args)
 {
+  auto& context = currentContext();
   constexpr char kValidArgs[] = "chrv";
 
   std::string arg = (args.size() == 0u) ? "c" : ((args[0] == "all") ? kValidArgs : args[0]);
@@ -219,14 +337,16 @@ int Command_Clear(const std::vector<std::string>& args)
 
   if(arg.find('r') != std::string::npos)
   {
-    results.clear();
+    context.results.Clear();
   }
 
   if(arg.find('v') != std::string::npos)
   {
-    defaultVariables.clear();
-    defaultInitializedVariableCache.clear();
-    defaultUninitializedVariableCache.clear();
+    context.defaultVariables.clear();
+    context.defaultInitializedVariableCache.clear();
+    context.defaultUninitializedVariableCache.clear();
+    context.constants.Clear();
+    context.variableGeneration++;
   }
 
   return 0;
@@ -234,16 +354,16 @@ int Command_Clear(const std::vector<std::string>& args)
 
 int Command_Exit(const std::vector<std::string>& args)
 {
+  auto& context = currentContext();
   static_cast<void>(args);
 
-  quit = true;
+  context.quit = true;
   return 0;
 }
 
-static CommandParser::CallbackCollection callbacks;
-
-void InitCommandParser(CommandParser& instance)
+void InitCommandParser(CommandParser& instance, KalkContext& context)
 {
+  auto& callbacks = context.commandCallbacks;
   instance.SetCallbacks(&callbacks);
 
   callbacks["prec"]      = Command_Prec;
@@ -257,6 +377,10 @@ void InitCommandParser(CommandParser& instance)
   callbacks["seed"]      = Command_Seed;
   callbacks["seedstr"]   = Command_SeedStr;
   callbacks["ans"]       = Command_Ans;
+  callbacks["cache"]     = Command_Cache;
+  callbacks["memo"]      = Command_Memo;
+  callbacks["stats"]     = Command_Stats;
+  callbacks["history"]   = Command_History;
   callbacks["list"]      = Command_List;
   callbacks["clear"]     = Command_Clear;
   callbacks["exit"]      = Command_Exit;
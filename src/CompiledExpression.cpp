@@ -0,0 +1,666 @@
+#include "CompiledExpression.hpp"
+#include "KalkContext.hpp"
+#include "Trace.hpp"
+#include "ValueArena.hpp"
+
+#include <cctype>
+#include <exception>
+#include <iostream>
+#include <unordered_set>
+
+#include <boost/format.hpp>
+
+static const std::unordered_set<std::string> kSharedStateIdentifiers = {"=", "ans", "del", "random", "chem.M", "sum", "prod"};
+// date() reads the clock even with an argument, since a date-only or time-only string is completed from the current time. sum() and prod() evaluate an
+// expression string that is opaque here.
+static const std::unordered_set<std::string> kImpureIdentifiers = {"=", "ans", "del", "random", "date", "sum", "prod"};
+
+class CompiledExpression::Compiler
+{
+  public:
+  Compiler(const std::string& expression, CompiledExpression& result)
+      : m_Expression(expression)
+      , m_Result(result)
+      , m_Context(currentContext())
+  {}
+
+  bool Run()
+  {
+    bool expectOperand = true;
+    while(SkipWhitespace())
+    {
+      const char current = m_Expression[m_Position];
+      if(expectOperand)
+      {
+        if(!ParseOperand(current, expectOperand))
+        {
+          return false;
+        }
+      }
+      else if(!ParseOperator(current, expectOperand))
+      {
+        return false;
+      }
+    }
+
+    if(expectOperand)
+    {
+      return m_Statement.instructions.empty() && m_Pending.empty();
+    }
+
+    return EndStatement();
+  }
+
+  private:
+  enum class PendingType
+  {
+    Unary,
+    Binary,
+    Parenthesis,
+    Function
+  };
+
+  struct PendingEntry
+  {
+    PendingType type;
+    int precedence;
+    Associativity associativity;
+    Instruction instruction;
+  };
+
+  static bool IsIdentifierStart(char value) { return std::isalpha(static_cast<unsigned char>(value)) != 0 || value == '_'; }
+  static bool IsIdentifierPart(char value) { return std::isalnum(static_cast<unsigned char>(value)) != 0 || value == '_' || value == '.'; }
+  static bool IsDigit(char value) { return std::isdigit(static_cast<unsigned char>(value)) != 0; }
+
+  bool SkipWhitespace()
+  {
+    while(m_Position < m_Expression.length() && std::isspace(static_cast<unsigned char>(m_Expression[m_Position])) != 0)
+    {
+      m_Position++;
+    }
+
+    return m_Position < m_Expression.length();
+  }
+
+  char Peek(std::size_t offset = 0u) const
+  {
+    return (m_Position + offset < m_Expression.length()) ? m_Expression[m_Position + offset] : '\0';
+  }
+
+  bool IsOperandStart(char value) const
+  {
+    return IsDigit(value) || (value == '.' && IsDigit(Peek(1u))) || IsIdentifierStart(value) || value == '(' || value == '"';
+  }
+
+  std::size_t AddIdentifier(const std::string& identifier)
+  {
+    if(kSharedStateIdentifiers.count(identifier) > 0u)
+    {
+      m_Result.m_UsesSharedState = true;
+    }
+
+    if(kImpureIdentifiers.count(identifier) > 0u)
+    {
+      m_Result.m_IsPure = false;
+    }
+
+    m_Result.m_Identifiers.push_back(identifier);
+    return m_Result.m_Identifiers.size() - 1u;
+  }
+
+  void Emit(const Instruction& instruction)
+  {
+    m_Statement.instructions.push_back(instruction);
+    if(instruction.code == OpCode::Value || instruction.code == OpCode::Variable)
+    {
+      m_Depth++;
+    }
+    else if(instruction.code == OpCode::BinaryOperator)
+    {
+      m_Depth--;
+    }
+    else if(instruction.code == OpCode::Function)
+    {
+      m_Depth = m_Depth + 1u - instruction.argumentCount;
+    }
+
+    if(m_Depth > m_Statement.depth)
+    {
+      m_Statement.depth = m_Depth;
+    }
+  }
+
+  bool EmitLiteral(IValueToken* value)
+  {
+    if(value == nullptr)
+    {
+      return false;
+    }
+
+    m_Result.m_Literals.emplace_back(value);
+    Emit({OpCode::Value, m_Result.m_Literals.size() - 1u, 0u, nullptr, nullptr, nullptr});
+    return true;
+  }
+
+  bool ParseOperand(char current, bool& expectOperand)
+  {
+    if(IsDigit(current) || (current == '.' && IsDigit(Peek(1u))))
+    {
+      if(m_Context.options.input_base != 10)
+      {
+        return false;
+      }
+
+      const std::size_t start = m_Position;
+      while(IsDigit(Peek()))
+      {
+        m_Position++;
+      }
+
+      if(Peek() == '.')
+      {
+        m_Position++;
+        while(IsDigit(Peek()))
+        {
+          m_Position++;
+        }
+      }
+
+      if(IsIdentifierPart(Peek()))
+      {
+        return false;
+      }
+
+      expectOperand = false;
+      return EmitLiteral(m_Context.defaultNumberConverter(m_Expression.substr(start, m_Position - start)));
+    }
+    else if(current == '"')
+    {
+      const std::size_t end = m_Expression.find('"', m_Position + 1u);
+      if(end == std::string::npos)
+      {
+        return false;
+      }
+
+      const std::string value = m_Expression.substr(m_Position + 1u, end - m_Position - 1u);
+      if(value.find('\\') != std::string::npos)
+      {
+        return false;
+      }
+
+      m_Position    = end + 1u;
+      expectOperand = false;
+      return EmitLiteral(m_Context.defaultStringConverter(value));
+    }
+    else if(IsIdentifierStart(current))
+    {
+      const std::size_t start = m_Position;
+      while(IsIdentifierPart(Peek()))
+      {
+        m_Position++;
+      }
+
+      const std::string_view identifier(m_Expression.data() + start, m_Position - start);
+      const auto function = m_Context.defaultFunctionIndex.Find(identifier);
+      if(function != nullptr)
+      {
+        if(Peek() != '(')
+        {
+          return false;
+        }
+
+        m_Position++;
+        m_Pending.push_back({PendingType::Function,
+                             0,
+                             Associativity::Left,
+                             {OpCode::Function, AddIdentifier(std::string(identifier)), 1u, nullptr, nullptr, function->second}});
+        m_Functions.push_back(function->first);
+
+        SkipWhitespace();
+        if(Peek() == ')')
+        {
+          m_Position++;
+          m_Pending.back().instruction.argumentCount = 0u;
+          return EndFunction(expectOperand);
+        }
+
+        expectOperand = true;
+        return true;
+      }
+
+      if(Peek() == '(')
+      {
+        return false;
+      }
+
+      Emit({OpCode::Variable, AddIdentifier(std::string(identifier)), 0u, nullptr, nullptr, nullptr});
+      expectOperand = false;
+      return true;
+    }
+    else if(current == '(')
+    {
+      m_Position++;
+      m_Pending.push_back({PendingType::Parenthesis, 0, Associativity::Left, {}});
+      return true;
+    }
+
+    const auto unaryOperator = m_Context.defaultUnaryOperators.find(current);
+    const auto callback      = m_Context.defaultUnaryOperatorCallbacks.find(current);
+    if(unaryOperator == m_Context.defaultUnaryOperators.cend() || callback == m_Context.defaultUnaryOperatorCallbacks.cend())
+    {
+      return false;
+    }
+
+    m_Position++;
+    m_Pending.push_back({PendingType::Unary,
+                         unaryOperator->second->GetPrecedence(),
+                         unaryOperator->second->GetAssociativity(),
+                         {OpCode::UnaryOperator, AddIdentifier(std::string(1u, current)), 1u, &callback->second, nullptr, nullptr}});
+    return true;
+  }
+
+  bool ParseOperator(char current, bool& expectOperand)
+  {
+    if(current == ')')
+    {
+      m_Position++;
+      if(!PopUntilGroup())
+      {
+        return false;
+      }
+
+      if(m_Pending.back().type == PendingType::Parenthesis)
+      {
+        m_Pending.pop_back();
+        return true;
+      }
+
+      return EndFunction(expectOperand);
+    }
+    else if(current == ',')
+    {
+      m_Position++;
+      if(!PopUntilGroup() || m_Pending.back().type != PendingType::Function)
+      {
+        return false;
+      }
+
+      m_Pending.back().instruction.argumentCount++;
+      expectOperand = true;
+      return true;
+    }
+    else if(current == ';')
+    {
+      m_Position++;
+      expectOperand = true;
+      return EndStatement();
+    }
+
+    const auto match = m_Context.defaultBinaryOperatorIndex.Match(std::string_view(m_Expression).substr(m_Position));
+
+    const IBinaryOperatorToken* binaryOperator        = nullptr;
+    const BinaryOperatorToken::CallbackType* callback = nullptr;
+    std::string identifier;
+    if(match.first != nullptr)
+    {
+      binaryOperator = match.first->first;
+      callback       = match.first->second;
+      identifier     = m_Expression.substr(m_Position, match.second);
+      m_Position += match.second;
+    }
+    else if(m_Context.defaultJuxtapositionOperator != nullptr && IsOperandStart(current))
+    {
+      binaryOperator = m_Context.defaultJuxtapositionOperator.get();
+      callback       = &m_Context.defaultJuxtapositionCallback;
+      identifier     = m_Context.defaultJuxtapositionOperator->GetIdentifier();
+    }
+    else
+    {
+      return false;
+    }
+
+    const int precedence              = binaryOperator->GetPrecedence();
+    const Associativity associativity = binaryOperator->GetAssociativity();
+    while(!m_Pending.empty() && (m_Pending.back().type == PendingType::Unary || m_Pending.back().type == PendingType::Binary) &&
+          (m_Pending.back().precedence > precedence || (m_Pending.back().precedence == precedence && associativity != Associativity::Right)))
+    {
+      Emit(m_Pending.back().instruction);
+      m_Pending.pop_back();
+    }
+
+    m_Pending.push_back({PendingType::Binary, precedence, associativity, {OpCode::BinaryOperator, AddIdentifier(identifier), 2u, nullptr, callback, nullptr}});
+    expectOperand = true;
+    return true;
+  }
+
+  bool PopUntilGroup()
+  {
+    while(!m_Pending.empty() && m_Pending.back().type != PendingType::Parenthesis && m_Pending.back().type != PendingType::Function)
+    {
+      Emit(m_Pending.back().instruction);
+      m_Pending.pop_back();
+    }
+
+    return !m_Pending.empty();
+  }
+
+  bool EndFunction(bool& expectOperand)
+  {
+    const auto function      = m_Functions.back();
+    const auto argumentCount = m_Pending.back().instruction.argumentCount;
+    if(argumentCount < function->GetMinArgumentCount() || argumentCount > function->GetMaxArgumentCount())
+    {
+      return false;
+    }
+
+    Emit(m_Pending.back().instruction);
+    m_Pending.pop_back();
+    m_Functions.pop_back();
+    expectOperand = false;
+    return true;
+  }
+
+  bool EndStatement()
+  {
+    while(!m_Pending.empty())
+    {
+      if(m_Pending.back().type == PendingType::Parenthesis || m_Pending.back().type == PendingType::Function)
+      {
+        return false;
+      }
+
+      Emit(m_Pending.back().instruction);
+      m_Pending.pop_back();
+    }
+
+    if(m_Statement.instructions.empty() || m_Depth != 1u)
+    {
+      return false;
+    }
+
+    m_Result.m_Statements.push_back(std::move(m_Statement));
+    m_Statement = {};
+    m_Depth     = 0u;
+    return true;
+  }
+
+  const std::string& m_Expression;
+  CompiledExpression& m_Result;
+  KalkContext& m_Context;
+  std::size_t m_Position = 0u;
+  std::size_t m_Depth    = 0u;
+  Statement m_Statement {};
+  std::vector<PendingEntry> m_Pending;
+  std::vector<const IFunctionToken*> m_Functions;
+};
+
+std::unique_ptr<CompiledExpression> CompiledExpression::Compile(const std::string& expression)
+{
+  const TraceSpan span("parse", "compile");
+  auto result = std::make_unique<CompiledExpression>();
+  try
+  {
+    Compiler compiler(expression, *result);
+    if(!compiler.Run())
+    {
+      return nullptr;
+    }
+  }
+  catch(const std::exception&)
+  {
+    return nullptr;
+  }
+
+  return result;
+}
+
+bool CompiledExpression::IsParallelSafe(std::string_view boundIdentifier) const
+{
+  const auto& context = currentContext();
+  if(m_UsesSharedState)
+  {
+    return false;
+  }
+
+  for(const auto& statement : m_Statements)
+  {
+    for(const auto& i : statement.instructions)
+    {
+      if(i.code == OpCode::Variable && m_Identifiers[i.index] != boundIdentifier &&
+         context.defaultInitializedVariableCache.count(m_Identifiers[i.index]) == 0u)
+      {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+static IValueToken* resolveVariable(const KalkContext& context, const std::string& identifier)
+{
+  const auto iter = context.defaultVariables.find(identifier);
+  if(iter != context.defaultVariables.cend())
+  {
+    return iter->second->As<IValueToken*>();
+  }
+
+  return context.defaultUnknownIdentifierCallback(identifier);
+}
+
+static IValueToken* retain(IValueToken* result, IValueToken* const* operands, std::size_t operandCount, CompiledExpression::TemporaryCollection& temporaries)
+{
+  for(std::size_t i = 0u; i < operandCount; i++)
+  {
+    if(operands[i] == result)
+    {
+      return result;
+    }
+  }
+
+  const auto arena = ValueArena::GetCurrent();
+  if(result->As<IVariableToken*>() == nullptr && (arena == nullptr || !arena->Owns(result)))
+  {
+    temporaries.emplace_back(result);
+  }
+
+  return result;
+}
+
+IValueToken* CompiledExpression::Evaluate(std::size_t statement, TemporaryCollection& temporaries, const Binding* binding) const
+{
+  const auto& context      = currentContext();
+  const auto& tmpStatement = m_Statements[statement];
+
+  std::vector<IValueToken*> stack;
+  stack.reserve(tmpStatement.depth);
+  for(const auto& i : tmpStatement.instructions)
+  {
+    switch(i.code)
+    {
+      case OpCode::Value:
+        stack.push_back(m_Literals[i.index].get());
+        break;
+      case OpCode::Variable:
+        if(binding != nullptr && m_Identifiers[i.index] == binding->identifier)
+        {
+          stack.push_back(binding->value);
+        }
+        else
+        {
+          stack.push_back(resolveVariable(context, m_Identifiers[i.index]));
+        }
+        break;
+      case OpCode::UnaryOperator:
+      {
+        IValueToken* rhs = stack.back();
+        stack.back()     = retain((*i.unaryCallback)(rhs), &rhs, 1u, temporaries);
+        break;
+      }
+      case OpCode::BinaryOperator:
+      {
+        IValueToken* operands[] = {stack[stack.size() - 2u], stack.back()};
+        stack.pop_back();
+        stack.back() = retain((*i.binaryCallback)(operands[0], operands[1]), operands, 2u, temporaries);
+        break;
+      }
+      case OpCode::Function:
+      {
+        const std::vector<IValueToken*> args(stack.end() - static_cast<std::ptrdiff_t>(i.argumentCount), stack.end());
+        stack.resize(stack.size() - i.argumentCount);
+        stack.push_back(retain((*i.functionCallback)(args), args.data(), args.size(), temporaries));
+        break;
+      }
+    }
+  }
+
+  return stack.back();
+}
+
+std::size_t ExpressionCacheKeyHash::operator()(const ExpressionCacheKey& value) const
+{
+  std::size_t result = std::hash<std::string>()(value.expression);
+  result ^= std::hash<long>()((static_cast<long>(value.input_base) << 8) ^ (static_cast<long>(value.jpo_precedence) << 16) ^
+                              (static_cast<long>(value.roundingMode) << 24) ^ (static_cast<long>(value.precision) << 32)) +
+            0x9e3779b9u + (result << 6) + (result >> 2);
+  return result;
+}
+
+std::size_t ResultCacheKeyHash::operator()(const ResultCacheKey& value) const
+{
+  std::size_t result = ExpressionCacheKeyHash()(value.expression);
+  result ^= std::hash<std::size_t>()(value.variableGeneration) + 0x9e3779b9u + (result << 6) + (result >> 2);
+  return result;
+}
+
+static void setKeyOptions(const KalkContext& context, ExpressionCacheKey& key)
+{
+  key.input_base     = context.options.input_base;
+  key.jpo_precedence = context.options.jpo_precedence;
+  key.precision      = mpfr::mpreal::get_default_prec();
+  key.roundingMode   = mpfr::mpreal::get_default_rnd();
+}
+
+std::shared_ptr<const CompiledExpression> compileCached(std::string_view expression)
+{
+  static thread_local ExpressionCacheKey key;
+  auto& context = currentContext();
+  if(!context.options.compile)
+  {
+    return nullptr;
+  }
+
+  key.expression.assign(expression.data(), expression.length());
+  setKeyOptions(context, key);
+
+  const auto cached = context.expressionCache.Find(key);
+  if(cached != nullptr)
+  {
+    return *cached;
+  }
+
+  std::shared_ptr<const CompiledExpression> result = CompiledExpression::Compile(key.expression);
+  context.expressionCache.Insert(key, result);
+  return result;
+}
+
+// Whitespace runs collapse to a single space and the ends are trimmed. Runs are not removed outright, since "2 3" and "23" differ. String literals,
+// escapes included, are copied verbatim, since their whitespace is part of the value.
+ResultCacheKey makeResultCacheKey(std::string_view expression)
+{
+  const auto& context = currentContext();
+  ResultCacheKey result;
+  auto& key = result.expression.expression;
+  key.reserve(expression.length());
+  bool pendingSpace = false;
+  bool inString     = false;
+  for(std::size_t i = 0u; i < expression.length(); i++)
+  {
+    const char current = expression[i];
+    if(inString)
+    {
+      key.push_back(current);
+      if(current == '\\' && i + 1u < expression.length())
+      {
+        key.push_back(expression[++i]);
+      }
+      else if(current == '"')
+      {
+        inString = false;
+      }
+
+      continue;
+    }
+
+    if(std::isspace(static_cast<unsigned char>(current)) != 0)
+    {
+      pendingSpace = !key.empty();
+      continue;
+    }
+
+    if(pendingSpace)
+    {
+      key.push_back(' ');
+      pendingSpace = false;
+    }
+
+    key.push_back(current);
+    inString = current == '"';
+  }
+
+  setKeyOptions(context, result.expression);
+  result.variableGeneration = context.variableGeneration;
+  return result;
+}
+
+// Variables are copied as variables, so a replayed result still prints by name under vnames.
+std::shared_ptr<const IValueToken> copyResult(const IValueToken* value)
+{
+  const auto nativeVariable = value->As<const NativeVariableType*>();
+  if(nativeVariable != nullptr)
+  {
+    return std::make_shared<NativeVariableType>(*nativeVariable);
+  }
+
+  const auto native = value->As<const NativeValueType*>();
+  if(native != nullptr)
+  {
+    return std::make_shared<NativeValueType>(*native);
+  }
+
+  const auto variable = value->As<const DefaultVariableType*>();
+  if(variable != nullptr)
+  {
+    return std::make_shared<DefaultVariableType>(*variable);
+  }
+
+  return std::make_shared<DefaultValueType>(*value->As<const DefaultValueType*>());
+}
+
+void printCacheStatistics()
+{
+  const auto& context = currentContext();
+  const auto lookups  = context.expressionCache.GetHits() + context.expressionCache.GetMisses();
+  std::cerr << "Expression cache" << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Hits" % context.expressionCache.GetHits()) << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Misses" % context.expressionCache.GetMisses()) << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Hit rate" %
+                (lookups > 0u ? static_cast<double>(context.expressionCache.GetHits()) / static_cast<double>(lookups) : 0.0))
+            << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|/%3%") % "Size" % context.expressionCache.GetSize() % context.expressionCache.GetCapacity()) << std::endl;
+  std::cerr << std::endl;
+}
+
+void printResultCacheStatistics()
+{
+  const auto& context = currentContext();
+  const auto lookups  = context.resultCache.GetHits() + context.resultCache.GetMisses();
+  std::cerr << "Result cache" << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Hits" % context.resultCache.GetHits()) << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Misses" % context.resultCache.GetMisses()) << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Hit rate" %
+                (lookups > 0u ? static_cast<double>(context.resultCache.GetHits()) / static_cast<double>(lookups) : 0.0))
+            << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|/%3%") % "Size" % context.resultCache.GetSize() % context.resultCache.GetCapacity()) << std::endl;
+  std::cerr << std::endl;
+}
@@ -0,0 +1,113 @@
+#ifndef __COMPILEDEXPRESSION_HPP__
+#define __COMPILEDEXPRESSION_HPP__
+
+#include "LruCache.hpp"
+#include "Setup.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class CompiledExpression
+{
+  public:
+  using TemporaryCollection = std::vector<std::unique_ptr<IValueToken>>;
+
+  // Value substituted for every reference to identifier, ahead of the context variables.
+  struct Binding
+  {
+    std::string_view identifier;
+    IValueToken* value;
+  };
+
+  static std::unique_ptr<CompiledExpression> Compile(const std::string& expression);
+
+  std::size_t GetStatementCount() const { return m_Statements.size(); }
+  bool IsParallelSafe(std::string_view boundIdentifier = {}) const;
+  bool IsPure() const { return m_IsPure; }
+  IValueToken* Evaluate(std::size_t statement, TemporaryCollection& temporaries, const Binding* binding = nullptr) const;
+
+  private:
+  enum class OpCode
+  {
+    Value,
+    Variable,
+    UnaryOperator,
+    BinaryOperator,
+    Function
+  };
+
+  struct Instruction
+  {
+    OpCode code;
+    std::size_t index;
+    std::size_t argumentCount;
+    const UnaryOperatorToken::CallbackType* unaryCallback;
+    const BinaryOperatorToken::CallbackType* binaryCallback;
+    const FunctionToken::CallbackType* functionCallback;
+  };
+
+  struct Statement
+  {
+    std::vector<Instruction> instructions;
+    std::size_t depth;
+  };
+
+  class Compiler;
+
+  std::vector<Statement> m_Statements;
+  std::vector<std::unique_ptr<IValueToken>> m_Literals;
+  std::vector<std::string> m_Identifiers;
+  bool m_UsesSharedState = false;
+  bool m_IsPure          = true;
+};
+
+struct ExpressionCacheKey
+{
+  std::string expression;
+  int input_base;
+  int jpo_precedence;
+  mpfr_prec_t precision;
+  mpfr_rnd_t roundingMode;
+
+  bool operator==(const ExpressionCacheKey& other) const
+  {
+    return input_base == other.input_base && jpo_precedence == other.jpo_precedence && precision == other.precision && roundingMode == other.roundingMode &&
+           expression == other.expression;
+  }
+};
+
+struct ExpressionCacheKeyHash
+{
+  std::size_t operator()(const ExpressionCacheKey& value) const;
+};
+
+using ExpressionCache = LruCache<ExpressionCacheKey, std::shared_ptr<const CompiledExpression>, ExpressionCacheKeyHash>;
+
+// Results of a pure expression, keyed by its normalized text and the options it was parsed with. The variable generation is bumped by every evaluation
+// that may have assigned or removed a variable, which retires the entries computed from the previous values.
+struct ResultCacheKey
+{
+  ExpressionCacheKey expression;
+  std::size_t variableGeneration;
+
+  bool operator==(const ResultCacheKey& other) const { return variableGeneration == other.variableGeneration && expression == other.expression; }
+};
+
+struct ResultCacheKeyHash
+{
+  std::size_t operator()(const ResultCacheKey& value) const;
+};
+
+using ResultCacheEntry = std::vector<std::shared_ptr<const IValueToken>>;
+using ResultCache      = LruCache<ResultCacheKey, ResultCacheEntry, ResultCacheKeyHash>;
+
+std::shared_ptr<const CompiledExpression> compileCached(std::string_view expression);
+ResultCacheKey makeResultCacheKey(std::string_view expression);
+std::shared_ptr<const IValueToken> copyResult(const IValueToken* value);
+void printCacheStatistics();
+void printResultCacheStatistics();
+
+#endif // __COMPILEDEXPRESSION_HPP__
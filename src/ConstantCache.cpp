@@ -0,0 +1,150 @@
+#include "ConstantCache.hpp"
+#include "KalkContext.hpp"
+
+#include <stdexcept>
+
+static DefaultArithmeticType generate(VariableGeneratorType generator, mpfr_prec_t precision, mpfr_rnd_t roundingMode)
+{
+  const auto previousPrecision    = mpfr::mpreal::get_default_prec();
+  const auto previousRoundingMode = mpfr::mpreal::get_default_rnd();
+  mpfr::mpreal::set_default_prec(precision);
+  mpfr::mpreal::set_default_rnd(roundingMode);
+
+  auto result = generator();
+
+  mpfr::mpreal::set_default_prec(previousPrecision);
+  mpfr::mpreal::set_default_rnd(previousRoundingMode);
+  return result;
+}
+
+static bool isUnchanged(const DefaultValueType& value, const DefaultArithmeticType& constant)
+{
+  if(value.GetType() != typeid(DefaultArithmeticType))
+  {
+    return false;
+  }
+
+  const auto& current = value.GetValue<DefaultArithmeticType>();
+  return mpfr::isnan(current) ? mpfr::isnan(constant) : current == constant;
+}
+
+void ConstantCache::Register(const std::string& identifier, VariableGeneratorType generator) { m_Generators[identifier] = generator; }
+
+void ConstantCache::Unregister(const std::string& identifier) { m_Generators.erase(identifier); }
+
+void ConstantCache::Clear()
+{
+  m_Generators.clear();
+  m_Sets.clear();
+  m_Stale.clear();
+}
+
+const DefaultArithmeticType& ConstantCache::Get(const std::string& identifier, mpfr_prec_t precision, mpfr_rnd_t roundingMode)
+{
+  auto& set  = Resolve(std::make_pair(precision, roundingMode));
+  auto value = set.values.find(identifier);
+  if(value == set.values.end())
+  {
+    const auto generator = m_Generators.find(identifier);
+    if(generator == m_Generators.end())
+    {
+      throw std::logic_error("Unregistered constant: " + identifier);
+    }
+
+    value = set.values.emplace(identifier, generate(generator->second, precision, roundingMode)).first;
+  }
+
+  return value->second;
+}
+
+void ConstantCache::Prefetch(const std::vector<std::string>& identifiers, mpfr_prec_t precision, mpfr_rnd_t roundingMode)
+{
+  if(precision < kBackgroundPrecision)
+  {
+    return;
+  }
+
+  auto& set = m_Sets[std::make_pair(precision, roundingMode)];
+  if(set.pending.valid())
+  {
+    return;
+  }
+
+  std::vector<std::pair<std::string, VariableGeneratorType>> jobs;
+  for(const auto& i : identifiers)
+  {
+    const auto generator = m_Generators.find(i);
+    if(generator != m_Generators.end() && set.values.count(i) == 0u)
+    {
+      jobs.emplace_back(i, generator->second);
+    }
+  }
+
+  if(jobs.empty())
+  {
+    return;
+  }
+
+  set.pending = std::async(std::launch::async, [jobs = std::move(jobs), precision, roundingMode]() {
+    ValueType result;
+    for(const auto& i : jobs)
+    {
+      result.emplace(i.first, generate(i.second, precision, roundingMode));
+    }
+
+    return result;
+  });
+}
+
+ConstantCache::ValueSet& ConstantCache::Resolve(const KeyType& key)
+{
+  auto& set = m_Sets[key];
+  if(set.pending.valid())
+  {
+    auto computed = set.pending.get();
+    set.values.merge(computed);
+  }
+
+  return set;
+}
+
+void refreshConstants(mpfr_prec_t previousPrecision, mpfr_rnd_t previousRoundingMode)
+{
+  auto& context   = currentContext();
+  auto& constants = context.constants;
+  auto& stale     = constants.GetStale();
+  if(stale.empty())
+  {
+    for(const auto& i : constants.GetGenerators())
+    {
+      const auto variable = context.defaultInitializedVariableCache.find(i.first);
+      if(variable != context.defaultInitializedVariableCache.end() &&
+         isUnchanged(*variable->second->As<DefaultVariableType*>(), constants.Get(i.first, previousPrecision, previousRoundingMode)))
+      {
+        stale.push_back(i.first);
+      }
+    }
+  }
+
+  constants.Prefetch(stale, mpfr::mpreal::get_default_prec(), mpfr::mpreal::get_default_rnd());
+  if(mpfr::mpreal::get_default_prec() < ConstantCache::kBackgroundPrecision)
+  {
+    synchronizeConstants();
+  }
+}
+
+void synchronizeConstants()
+{
+  auto& context = currentContext();
+  auto& stale   = context.constants.GetStale();
+  for(const auto& i : stale)
+  {
+    const auto variable = context.defaultInitializedVariableCache.find(i);
+    if(variable != context.defaultInitializedVariableCache.end())
+    {
+      *variable->second->As<DefaultVariableType*>() = context.constants.Get(i, mpfr::mpreal::get_default_prec(), mpfr::mpreal::get_default_rnd());
+    }
+  }
+
+  stale.clear();
+}
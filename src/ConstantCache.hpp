@@ -0,0 +1,58 @@
+#ifndef __CONSTANTCACHE_HPP__
+#define __CONSTANTCACHE_HPP__
+
+#include "Setup.hpp"
+
+#include <future>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class ConstantCache
+{
+  public:
+  static constexpr mpfr_prec_t kBackgroundPrecision = 1 << 16;
+
+  using GeneratorCollection = std::unordered_map<std::string, VariableGeneratorType>;
+
+  ConstantCache() = default;
+
+  ConstantCache(const ConstantCache&)            = delete;
+  ConstantCache& operator=(const ConstantCache&) = delete;
+
+  const GeneratorCollection& GetGenerators() const { return m_Generators; }
+  bool IsRegistered(const std::string& identifier) const { return m_Generators.count(identifier) > 0u; }
+  std::size_t GetSetCount() const { return m_Sets.size(); }
+
+  void Register(const std::string& identifier, VariableGeneratorType generator);
+  void Unregister(const std::string& identifier);
+  void Clear();
+
+  const DefaultArithmeticType& Get(const std::string& identifier, mpfr_prec_t precision, mpfr_rnd_t roundingMode);
+  void Prefetch(const std::vector<std::string>& identifiers, mpfr_prec_t precision, mpfr_rnd_t roundingMode);
+
+  std::vector<std::string>& GetStale() { return m_Stale; }
+
+  private:
+  using KeyType   = std::pair<mpfr_prec_t, mpfr_rnd_t>;
+  using ValueType = std::unordered_map<std::string, DefaultArithmeticType>;
+
+  struct ValueSet
+  {
+    ValueType values;
+    std::future<ValueType> pending;
+  };
+
+  ValueSet& Resolve(const KeyType& key);
+
+  GeneratorCollection m_Generators;
+  std::map<KeyType, ValueSet> m_Sets;
+  std::vector<std::string> m_Stale;
+};
+
+void refreshConstants(mpfr_prec_t previousPrecision, mpfr_rnd_t previousRoundingMode);
+void synchronizeConstants();
+
+#endif // __CONSTANTCACHE_HPP__
@@ -0,0 +1,47 @@
+#include "DecimalFormatter.hpp"
+
+#include <cstdio>
+#include <stdexcept>
+
+std::string_view DecimalFormatter::Format(const DefaultArithmeticType& value, int digits)
+{
+  if(digits < 0)
+  {
+    const auto tmpString = value.toString(digits);
+    m_Buffer.assign(tmpString.cbegin(), tmpString.cend());
+    return std::string_view(m_Buffer.data(), m_Buffer.size());
+  }
+
+  while(true)
+  {
+    const int length = mpfr_snprintf(m_Buffer.data(), m_Buffer.size(), "%.*RNg", digits, value.mpfr_srcptr());
+    if(length < 0)
+    {
+      throw std::runtime_error("Could not format value");
+    }
+    else if(static_cast<std::size_t>(length) < m_Buffer.size())
+    {
+      return std::string_view(m_Buffer.data(), static_cast<std::size_t>(length));
+    }
+
+    m_Buffer.resize(static_cast<std::size_t>(length) + 1u);
+  }
+}
+
+std::string_view DecimalFormatter::Format(NativeArithmeticType value, int digits)
+{
+  while(true)
+  {
+    const int length = std::snprintf(m_Buffer.data(), m_Buffer.size(), "%.*g", digits, value);
+    if(length < 0)
+    {
+      throw std::runtime_error("Could not format value");
+    }
+    else if(static_cast<std::size_t>(length) < m_Buffer.size())
+    {
+      return std::string_view(m_Buffer.data(), static_cast<std::size_t>(length));
+    }
+
+    m_Buffer.resize(static_cast<std::size_t>(length) + 1u);
+  }
+}
@@ -0,0 +1,19 @@
+#ifndef __DECIMALFORMATTER_HPP__
+#define __DECIMALFORMATTER_HPP__
+
+#include "Setup.hpp"
+
+#include <string_view>
+#include <vector>
+
+class DecimalFormatter
+{
+  public:
+  std::string_view Format(const DefaultArithmeticType& value, int digits);
+  std::string_view Format(NativeArithmeticType value, int digits);
+
+  private:
+  std::vector<char> m_Buffer = std::vector<char>(64u);
+};
+
+#endif // __DECIMALFORMATTER_HPP__
@@ -1,31 +1,186 @@
+#include "Aggregates.hpp"
+#include "Combinatorics.hpp"
+#include "DecimalFormatter.hpp"
+#include "KalkContext.hpp"
+#include "LruCache.hpp"
+#include "NumericSetup.hpp"
+#include "RadixWriter.hpp"
+#include "Trace.hpp"
 #include "Setup.hpp"
+#include "ValueArena.hpp"
+#include "WorkerScope.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <future>
 #include <iostream>
 #include <limits>
 #include <memory>
+#include <optional>
 #include <sstream>
+#include <type_traits>
+#include <unordered_map>
 
 #include <gmpxx.h>
+#include <boost/algorithm/string.hpp>
 #include <boost/date_time/date_facet.hpp>
 #include <boost/date_time/time_duration.hpp>
 #include <boost/date_time/time_facet.hpp>
 #include <boost/format.hpp>
 
+struct LiteralInternTable
+{
+  mpfr_prec_t precision   = 0;
+  mpfr_rnd_t roundingMode = MPFR_RNDN;
+  int base                = 0;
+  LruCache<std::string, DefaultValueType> values {4096u};
+};
+
+// Parses plain "digits[.digits]" literals whose digits fit in a machine word. The fraction is applied with a single mpfr_div_ui on exact operands, which
+// rounds the same as mpfr_set_str on the full text. Anything else is left to the GMP/MPFR string parsers.
+static bool parseShortLiteral(const std::string& value, int base, DefaultValueType& result)
+{
+  const auto radix       = static_cast<unsigned long>(base);
+  unsigned long mantissa = 0u;
+  unsigned long divisor  = 1u;
+  bool hasPoint          = false;
+  bool hasDigit          = false;
+  for(const char i : value)
+  {
+    if(i == '.' && !hasPoint)
+    {
+      hasPoint = true;
+      continue;
+    }
+
+    const int digit = digitValue(i);
+    if(digit < 0 || digit >= base)
+    {
+      return false;
+    }
+
+    const auto next = static_cast<unsigned long>(digit);
+    if(mantissa > (std::numeric_limits<unsigned long>::max() - next) / radix)
+    {
+      return false;
+    }
+
+    mantissa = (mantissa * radix) + next;
+    hasDigit = true;
+    if(hasPoint)
+    {
+      if(divisor > std::numeric_limits<unsigned long>::max() / radix)
+      {
+        return false;
+      }
+
+      divisor *= radix;
+    }
+  }
+
+  if(!hasDigit)
+  {
+    return false;
+  }
+  else if(!hasPoint)
+  {
+    result = DefaultIntegerType(mantissa);
+    return true;
+  }
+
+  const DefaultArithmeticType numerator(mantissa, std::numeric_limits<unsigned long>::digits);
+  DefaultArithmeticType quotient;
+  mpfr_div_ui(quotient.mpfr_ptr(), numerator.mpfr_srcptr(), divisor, mpfr::mpreal::get_default_rnd());
+  result = quotient;
+  return true;
+}
+
 static IValueToken* numberConverter(const std::string& value)
 {
-  return new DefaultValueType(mpfr::mpreal(value, mpfr::mpreal::get_default_prec(), options.input_base, mpfr::mpreal::get_default_rnd()));
+  const auto& context = currentContext();
+  static thread_local LiteralInternTable internTable;
+  if(internTable.precision != mpfr::mpreal::get_default_prec() || internTable.roundingMode != mpfr::mpreal::get_default_rnd() ||
+     internTable.base != context.options.input_base)
+  {
+    internTable.values.Clear();
+    internTable.precision    = mpfr::mpreal::get_default_prec();
+    internTable.roundingMode = mpfr::mpreal::get_default_rnd();
+    internTable.base         = context.options.input_base;
+  }
+
+  const auto cached = internTable.values.Find(value);
+  if(cached != nullptr)
+  {
+    return new DefaultValueType(*cached);
+  }
+
+  DefaultValueType result(nullptr);
+  if(!parseShortLiteral(value, context.options.input_base, result))
+  {
+    DefaultIntegerType integer;
+    if(integer.set_str(value, context.options.input_base) == 0)
+    {
+      result = integer;
+    }
+    else
+    {
+      result = mpfr::mpreal(value, mpfr::mpreal::get_default_prec(), context.options.input_base, mpfr::mpreal::get_default_rnd());
+    }
+  }
+
+  internTable.values.Insert(value, result);
+  return new DefaultValueType(result);
 }
 
 static IValueToken* stringConverter(const std::string& value) { return new DefaultValueType(value); }
 
-struct GreaterComparer
+static bool isNumber(const IValueToken* value) { return value->GetType() == typeid(DefaultArithmeticType) || value->GetType() == typeid(DefaultIntegerType); }
+
+static bool isInteger(const IValueToken* value) { return value->GetType() == typeid(DefaultIntegerType); }
+
+static DefaultArithmeticType toArithmetic(const IValueToken* value)
 {
-  bool operator()(IValueToken* a, IValueToken* b) const
+  if(isInteger(value))
   {
-    return a->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>() < b->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>();
+    return DefaultArithmeticType(value->As<const DefaultValueType*>()->GetValue<DefaultIntegerType>().get_mpz_t());
   }
-};
+
+  return value->As<const DefaultValueType*>()->GetValue<DefaultArithmeticType>();
+}
+
+static DefaultIntegerType toInteger(const IValueToken* value)
+{
+  if(isInteger(value))
+  {
+    return value->As<const DefaultValueType*>()->GetValue<DefaultIntegerType>();
+  }
+
+  const auto& tmpValue = value->As<const DefaultValueType*>()->GetValue<DefaultArithmeticType>();
+  if(mpfr_number_p(tmpValue.mpfr_srcptr()) == 0)
+  {
+    throw std::domain_error("Integer operation on non-finite value");
+  }
+
+  DefaultIntegerType result;
+  mpfr_get_z(result.get_mpz_t(), tmpValue.mpfr_srcptr(), MPFR_RNDZ);
+  return result;
+}
+
+// Integer as a non-negative machine word count.
+static unsigned long toCount(const DefaultIntegerType& value)
+{
+  if(sgn(value) < 0)
+  {
+    throw std::range_error("Value cannot be negative");
+  }
+  else if(!value.fits_ulong_p())
+  {
+    throw std::range_error("Value out of range");
+  }
+
+  return value.get_ui();
+}
 
 static std::string formatDateTime(const boost::posix_time::ptime& dateTime, const std::string& format)
 {
@@ -50,48 +205,275 @@ static std::string operator*(const std::string& lhs, std::size_t rhs)
   return result;
 }
 
-int compare(const IValueToken* a, const IValueToken* b)
+template<class T>
+static constexpr bool isNumberType = std::is_same_v<T, DefaultArithmeticType> || std::is_same_v<T, DefaultIntegerType>;
+
+template<class TLhs, class TRhs, class TExpectedLhs, class TExpectedRhs>
+static constexpr bool isTypePair = std::is_same_v<TLhs, TExpectedLhs> && std::is_same_v<TRhs, TExpectedRhs>;
+
+static const DefaultArithmeticType& toArithmetic(const DefaultArithmeticType& value) { return value; }
+
+static DefaultArithmeticType toArithmetic(const DefaultIntegerType& value) { return DefaultArithmeticType(value.get_mpz_t()); }
+
+template<class T>
+static std::string toConcatString(const T& value)
+{
+  if constexpr(std::is_same_v<T, std::nullptr_t>)
+  {
+    return std::string();
+  }
+  else if constexpr(std::is_same_v<T, std::string>)
+  {
+    return value;
+  }
+  else
+  {
+    return DefaultValueType(value).ToString();
+  }
+}
+
+static boost::posix_time::time_duration scaleDuration(const boost::posix_time::time_duration& value, double factor)
+{
+  return boost::posix_time::nanoseconds(static_cast<long>(static_cast<double>(value.total_nanoseconds()) * factor));
+}
+
+template<class TOperation>
+static typename TOperation::ResultType dispatch(const std::string& name, const IValueToken* lhs, const IValueToken* rhs)
+{
+  const auto lhsValue = lhs->As<const DefaultValueType*>();
+  const auto rhsValue = rhs->As<const DefaultValueType*>();
+  const auto handler  = BinaryDispatchTable<TOperation, DefaultValueType, DefaultTypeList>::Find(*lhsValue, *rhsValue);
+  if(handler == nullptr)
+  {
+    throw SyntaxError((boost::format("Unsupported operand types for %1%: %2%, %3%") % name % lhs->GetType().name() % rhs->GetType().name()).str());
+  }
+
+  return handler(*lhsValue, *rhsValue);
+}
+
+// Runs function(chunk, begin, end) over contiguous chunks of [0, count), on worker threads when there is more than one chunk. On a thread that is already
+// a worker the chunks run serially, so nested calls do not multiply the thread count.
+template<class TFunction>
+static void forEachChunk(std::size_t count, std::size_t chunkCount, const TFunction& function)
+{
+  if(chunkCount <= 1u)
+  {
+    function(0u, 0u, count);
+    return;
+  }
+  else if(WorkerScope::IsActive())
+  {
+    for(std::size_t i = 0u; i < chunkCount; i++)
+    {
+      function(i, (count * i) / chunkCount, (count * (i + 1u)) / chunkCount);
+    }
+
+    return;
+  }
+
+  const auto precision    = mpfr::mpreal::get_default_prec();
+  const auto roundingMode = mpfr::mpreal::get_default_rnd();
+  std::vector<std::future<void>> workers;
+  for(std::size_t i = 1u; i < chunkCount; i++)
+  {
+    workers.push_back(std::async(std::launch::async, [&function, count, chunkCount, precision, roundingMode, i]() {
+      const WorkerScope workerScope;
+      mpfr::mpreal::set_default_prec(precision);
+      mpfr::mpreal::set_default_rnd(roundingMode);
+      function(i, (count * i) / chunkCount, (count * (i + 1u)) / chunkCount);
+    }));
+  }
+
+  {
+    const WorkerScope workerScope;
+    function(0u, 0u, count / chunkCount);
+  }
+
+  for(auto& i : workers)
+  {
+    i.get();
+  }
+}
+
+// Chunks an aggregate over count values splits into: one per aggregate thread, once there are enough values to pay for the threads.
+static std::size_t aggregateChunkCount(std::size_t count)
+{
+  constexpr std::size_t kParallelThreshold = 1u << 14u;
+  return count < kParallelThreshold ? 1u : std::max(1u, currentContext().options.agg_threads);
+}
+
+template<class T>
+static constexpr bool isVectorType = std::is_same_v<T, DefaultVectorType>;
+
+template<class TLhs, class TRhs>
+static constexpr bool isVectorPair = (isVectorType<TLhs> && (isVectorType<TRhs> || isNumberType<TRhs>)) || (isNumberType<TLhs> && isVectorType<TRhs>);
+
+static bool isVector(const IValueToken* value) { return value->GetType() == typeid(DefaultVectorType); }
+
+static const DefaultVectorType& toVector(const IValueToken* value) { return value->As<const DefaultValueType*>()->GetValue<DefaultVectorType>(); }
+
+template<class TFunction>
+static IValueToken* elementwise(const DefaultVectorType& values, const TFunction& function)
+{
+  DefaultVectorType result(values.GetSize());
+  forEachChunk(values.GetSize(), aggregateChunkCount(values.GetSize()), [&values, &result, &function](std::size_t, std::size_t begin, std::size_t end) {
+    for(std::size_t i = begin; i < end; i++)
+    {
+      result[i] = function(values[i]);
+    }
+  });
+
+  return makeValue(std::move(result));
+}
+
+// Applies function to each pair of elements. A number operand is paired with every element of the vector operand.
+template<class TLhs, class TRhs, class TFunction>
+static IValueToken* elementwise(const TLhs& lhs, const TRhs& rhs, const TFunction& function)
 {
-  auto aValue = a->As<const DefaultValueType*>();
-  auto bValue = b->As<const DefaultValueType*>();
-  if(a->GetType() == typeid(std::string) && b->GetType() == typeid(std::string))
+  if constexpr(isVectorType<TLhs> && isVectorType<TRhs>)
+  {
+    if(lhs.GetSize() != rhs.GetSize())
+    {
+      throw SyntaxError((boost::format("Vector length mismatch: %1%, %2%") % lhs.GetSize() % rhs.GetSize()).str());
+    }
+
+    DefaultVectorType result(lhs.GetSize());
+    forEachChunk(lhs.GetSize(), aggregateChunkCount(lhs.GetSize()), [&lhs, &rhs, &result, &function](std::size_t, std::size_t begin, std::size_t end) {
+      for(std::size_t i = begin; i < end; i++)
+      {
+        result[i] = function(lhs[i], rhs[i]);
+      }
+    });
+
+    return makeValue(std::move(result));
+  }
+  else if constexpr(isVectorType<TLhs>)
+  {
+    const auto& scalar = toArithmetic(rhs);
+    return elementwise(lhs, [&scalar, &function](const DefaultArithmeticType& value) { return function(value, scalar); });
+  }
+  else
   {
-    return aValue->GetValue<std::string>().compare(bValue->GetValue<std::string>());
+    const auto& scalar = toArithmetic(lhs);
+    return elementwise(rhs, [&scalar, &function](const DefaultArithmeticType& value) { return function(scalar, value); });
   }
-  else if(a->GetType() == typeid(boost::posix_time::ptime) && b->GetType() == typeid(boost::posix_time::ptime))
+}
+
+// Applies function to a number, or to every element of a vector.
+template<class TFunction>
+static IValueToken* broadcast(const IValueToken* value, const TFunction& function)
+{
+  return isVector(value) ? elementwise(toVector(value), function) : makeValue(function(toArithmetic(value)));
+}
+
+template<class TFunction>
+static IValueToken* broadcast(const IValueToken* lhs, const IValueToken* rhs, const TFunction& function)
+{
+  if(isVector(lhs))
   {
-    return aValue->GetValue<boost::posix_time::ptime>() < bValue->GetValue<boost::posix_time::ptime>() ?
-             -1 :
-             (aValue->GetValue<boost::posix_time::ptime>() > bValue->GetValue<boost::posix_time::ptime>() ? 1 : 0);
+    return isVector(rhs) ? elementwise(toVector(lhs), toVector(rhs), function) : elementwise(toVector(lhs), toArithmetic(rhs), function);
   }
-  else if(a->GetType() == typeid(boost::posix_time::time_duration) && bValue->GetType() == typeid(boost::posix_time::time_duration))
+  else if(isVector(rhs))
   {
-    return aValue->GetValue<boost::posix_time::time_duration>() < bValue->GetValue<boost::posix_time::time_duration>() ?
-             -1 :
-             (aValue->GetValue<boost::posix_time::time_duration>() > bValue->GetValue<boost::posix_time::time_duration>() ? 1 : 0);
+    return elementwise(toArithmetic(lhs), toVector(rhs), function);
   }
-  else if(a->GetType() == typeid(std::nullptr_t) && b->GetType() == typeid(std::nullptr_t))
+
+  return makeValue(function(toArithmetic(lhs), toArithmetic(rhs)));
+}
+
+namespace
+{
+struct Comparison
+{
+  using ResultType = int;
+
+  template<class TLhs, class TRhs>
+  static constexpr bool Supports = (std::is_same_v<TLhs, TRhs> && !isNumberType<TLhs> && !isVectorType<TLhs>) || (isNumberType<TLhs> && isNumberType<TRhs>);
+
+  static int Apply(std::nullptr_t, std::nullptr_t) { return 0; }
+
+  static int Apply(const std::string& lhs, const std::string& rhs) { return lhs.compare(rhs); }
+
+  static int Apply(const DefaultIntegerType& lhs, const DefaultIntegerType& rhs) { return cmp(lhs, rhs); }
+
+  template<class T>
+  static int Apply(const T& lhs, const T& rhs) { return lhs < rhs ? -1 : (lhs > rhs ? 1 : 0); }
+
+  template<class TLhs, class TRhs>
+  static int Apply(const TLhs& lhs, const TRhs& rhs) { return Apply(toArithmetic(lhs), toArithmetic(rhs)); }
+};
+} // namespace
+
+int compare(const IValueToken* a, const IValueToken* b) { return dispatch<Comparison>("comparison", a, b); }
+
+static const std::unordered_map<std::string, mpfr_rnd_t> rmodeNameMap2 = {
+    {"N", mpfr_rnd_t::MPFR_RNDN},
+    {"Z", mpfr_rnd_t::MPFR_RNDZ},
+    {"U", mpfr_rnd_t::MPFR_RNDU},
+    {"D", mpfr_rnd_t::MPFR_RNDD},
+    {"A", mpfr_rnd_t::MPFR_RNDA},
+    {"F", mpfr_rnd_t::MPFR_RNDF},
+    {"NA", mpfr_rnd_t::MPFR_RNDNA},
+};
+
+mpfr_rnd_t strToRmode(const std::string value)
+{
+  const auto iter = rmodeNameMap2.find(boost::to_upper_copy(value));
+  if(iter != rmodeNameMap2.cend())
   {
-    return 0;
+    return iter->second;
   }
   else
   {
-    return aValue->GetValue<DefaultArithmeticType>() < bValue->GetValue<DefaultArithmeticType>() ?
-             -1 :
-             (aValue->GetValue<DefaultArithmeticType>() > bValue->GetValue<DefaultArithmeticType>() ? 1 : 0);
+    throw std::domain_error("Invalid rounding mode");
+  }
+}
+
+// Short decimal output is formatted in one go. Long output, and output in other bases, is streamed as it is converted.
+static void printArithmetic(const DefaultArithmeticType& value, int digits, int base)
+{
+  if(digits >= 0 && (digits >= kStreamingDigits || base != 10))
+  {
+    const TraceSpan streamSpan("output", "format and write");
+    writeFloat(std::cout, value, digits, base);
+    return;
+  }
+
+  static thread_local DecimalFormatter formatter;
+  std::string_view tmpString;
+  {
+    const TraceSpan formatSpan("output", "format");
+    tmpString = formatter.Format(value, digits);
   }
+
+  const TraceSpan writeSpan("output", "write");
+  std::cout.write(tmpString.data(), static_cast<std::streamsize>(tmpString.size()));
 }
 
 void printValue(const DefaultValueType& value)
 {
-  if(options.vnames && value.IsType<DefaultVariableType>())
+  const TraceSpan span("output", "printValue");
+  const auto& context = currentContext();
+  if(context.options.vnames && value.IsType<DefaultVariableType>())
   {
     const auto& variable = value.As<const DefaultVariableType&>();
     std::cout << variable.GetIdentifier();
   }
   else if(value.GetType() == typeid(DefaultArithmeticType))
   {
-    std::cout << value.GetValue<DefaultArithmeticType>().toString(options.digits, options.output_base, mpfr::mpreal::get_default_rnd());
+    printArithmetic(value.GetValue<DefaultArithmeticType>(), context.options.digits, context.options.output_base);
+  }
+  else if(value.GetType() == typeid(DefaultIntegerType))
+  {
+    const auto& integer = value.GetValue<DefaultIntegerType>();
+    if(mpz_sizeinbase(integer.get_mpz_t(), context.options.output_base) >= static_cast<std::size_t>(kStreamingDigits))
+    {
+      writeInteger(std::cout, integer, context.options.output_base);
+    }
+    else
+    {
+      std::cout << integer.get_str(context.options.output_base);
+    }
   }
   else if(value.GetType() == typeid(boost::posix_time::ptime))
   {
@@ -101,32 +483,52 @@ void printValue(const DefaultValueType& value)
   {
     std::cout << value.GetValue<boost::posix_time::time_duration>();
   }
+  else if(value.GetType() == typeid(DefaultVectorType))
+  {
+    const auto& elements = value.GetValue<DefaultVectorType>();
+    std::cout << '[';
+    for(std::size_t i = 0u; i < elements.GetSize(); i++)
+    {
+      std::cout << (i > 0u ? ", " : "");
+      printArithmetic(elements[i], context.options.digits, context.options.output_base);
+    }
+
+    std::cout << ']';
+  }
   else
   {
     std::cout << value.ToString();
   }
 
+  const TraceSpan writeSpan("output", "write");
   std::cout << std::endl;
 }
 
 const DefaultValueType* ans(int index)
 {
-  if(results.empty())
+  const auto& context = currentContext();
+  if(context.results.GetSize() == 0u)
   {
     throw std::runtime_error("No results available");
   }
 
   if(index < 0)
   {
-    index = static_cast<int>(results.size()) + index;
+    index = static_cast<int>(context.results.GetSize()) + index;
+  }
+
+  if(index < 0 || static_cast<std::size_t>(index) >= context.results.GetSize())
+  {
+    throw SyntaxError((boost::format("Results index out of range: %1%/%2%") % index % context.results.GetSize()).str());
   }
 
-  if(index < 0 || static_cast<std::size_t>(index) >= results.size())
+  const auto result = context.results.Get(static_cast<std::size_t>(index));
+  if(result == nullptr)
   {
-    throw SyntaxError((boost::format("Results index out of range: %1%/%2%") % index % results.size()).str());
+    throw SyntaxError((boost::format("Result no longer retained: %1%") % index).str());
   }
 
-  return &results.at(static_cast<std::size_t>(index));
+  return result;
 }
 
 static std::string makeCompoundString(std::string text)
@@ -167,78 +569,57 @@ static std::string makeCompoundString(std::string text)
   return result;
 }
 
-static void addUnaryOperator(const UnaryOperatorToken::CallbackType& callback,
-                             char identifier,
-                             int precedence,
-                             Associativity associativity,
-                             const std::string& title       = "",
-                             const std::string& description = "")
+static void addLazyVariable(VariableGeneratorType generator, const std::string& identifier, const char* title = "", const char* description = "")
 {
-  auto tmpNew                           = std::make_unique<UnaryOperatorToken>(identifier, callback, precedence, associativity);
-  auto tmp                              = tmpNew.get();
-  defaultUnaryOperatorCache[identifier] = std::move(tmpNew);
-  defaultUnaryOperators[identifier]     = tmp;
+  auto& context = currentContext();
+  context.constants.Register(identifier, generator);
 
-  unaryOperatorInfoMap.push_back(std::make_tuple(tmp, title, description));
+  context.variableInfoMap.push_back(std::make_tuple(identifier, title, description));
 }
 
-static void addBinaryOperator(const BinaryOperatorToken::CallbackType& callback,
-                              const std::string& identifier,
-                              int precedence,
-                              Associativity associativity,
-                              const std::string& title       = "",
-                              const std::string& description = "")
+static DefaultValueType* materializeVariable(const std::string& identifier)
 {
-  auto tmpNew                            = std::make_unique<BinaryOperatorToken>(identifier, callback, precedence, associativity);
-  auto tmp                               = tmpNew.get();
-  defaultBinaryOperatorCache[identifier] = std::move(tmpNew);
-  defaultBinaryOperators[identifier]     = tmp;
-
-  binaryOperatorInfoMap.push_back(std::make_tuple(tmp, title, description));
-}
+  auto& context = currentContext();
+  if(!context.constants.IsRegistered(identifier))
+  {
+    return nullptr;
+  }
 
-static void addFunction(const FunctionToken::CallbackType& callback,
-                        const std::string& identifier,
-                        std::size_t minArgs            = 0u,
-                        std::size_t maxArgs            = FunctionToken::GetArgumentCountMaxLimit(),
-                        const std::string& title       = "",
-                        const std::string& description = "")
-{
-  auto tmpNew                      = std::make_unique<FunctionToken>(identifier, callback, minArgs, maxArgs);
-  auto tmp                         = tmpNew.get();
-  defaultFunctionCache[identifier] = std::move(tmpNew);
-  defaultFunctions[identifier]     = tmp;
+  const auto& value = context.constants.Get(identifier, mpfr::mpreal::get_default_prec(), mpfr::mpreal::get_default_rnd());
 
-  functionInfoMap.push_back(std::make_tuple(tmp, title, description));
+  auto tmpNew                                         = std::make_unique<DefaultVariableType>(identifier, value);
+  auto result                                         = tmpNew.get();
+  context.defaultInitializedVariableCache[identifier] = std::move(tmpNew);
+  context.defaultVariables[identifier]                = result;
+  return result;
 }
 
-template<class T>
-static void addVariable(const T& value, const std::string& identifier, const std::string& title = "", const std::string& description = "")
-{
-  auto tmpNew                                 = std::make_unique<DefaultVariableType>(identifier, value);
-  auto tmp                                    = tmpNew.get();
-  defaultInitializedVariableCache[identifier] = std::move(tmpNew);
-  defaultVariables[identifier]                = tmp;
+template<long TBits, bool TSigned>
+static DefaultArithmeticType integerMin() { return TSigned ? -mpfr::exp2(mpfr::mpreal(TBits - 1l)) : mpfr::mpreal(0); }
 
-  variableInfoMap.push_back(std::make_tuple(tmp, title, description));
-}
+template<long TBits, bool TSigned>
+static DefaultArithmeticType integerMax() { return mpfr::exp2(mpfr::mpreal(TSigned ? TBits - 1l : TBits)) - 1; }
 
 static void removeVariable(const std::string& identifier)
 {
-  defaultVariables.erase(identifier);
-  if(defaultInitializedVariableCache.erase(identifier) == 0u)
+  auto& context = currentContext();
+  context.constants.Unregister(identifier);
+  context.defaultVariables.erase(identifier);
+  if(context.defaultInitializedVariableCache.erase(identifier) == 0u)
   {
-    defaultUninitializedVariableCache.erase(identifier);
+    context.defaultUninitializedVariableCache.erase(identifier);
   }
 }
 
 static DefaultValueType* addNewVariable(const std::string& identifier)
 {
-  auto tmpNew                                   = std::make_unique<DefaultVariableType>(identifier);
-  auto result                                   = tmpNew.get();
-  defaultUninitializedVariableCache[identifier] = std::move(tmpNew);
-  defaultVariables[identifier]                  = result;
-  return result;
+  const auto lazyResult = materializeVariable(identifier);
+  if(lazyResult != nullptr)
+  {
+    return lazyResult;
+  }
+
+  return addUninitializedVariable<DefaultVariableType>(identifier);
 }
 
 #ifndef __REGION__UNOPS
@@ -249,11 +630,15 @@ static IValueToken* UnaryOperator_Plus(IValueToken* rhs)
   {
     const auto& tmpValue = rhs->As<DefaultValueType*>()->GetValue<boost::posix_time::time_duration>();
     const boost::posix_time::time_duration zero;
-    return new DefaultValueType(tmpValue < zero ? -tmpValue : tmpValue);
+    return makeValue(tmpValue < zero ? -tmpValue : tmpValue);
+  }
+  else if(isInteger(rhs))
+  {
+    return makeValue(DefaultIntegerType(abs(rhs->As<DefaultValueType*>()->GetValue<DefaultIntegerType>())));
   }
   else
   {
-    return new DefaultValueType(mpfr::abs(rhs->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
+    return broadcast(rhs, [](const auto& x) { return mpfr::abs(x); });
   }
 }
 
@@ -261,257 +646,279 @@ static IValueToken* UnaryOperator_Minus(IValueToken* rhs)
 {
   if(rhs->GetType() == typeid(boost::posix_time::time_duration))
   {
-    return new DefaultValueType(-rhs->As<DefaultValueType*>()->GetValue<boost::posix_time::time_duration>());
+    return makeValue(-rhs->As<DefaultValueType*>()->GetValue<boost::posix_time::time_duration>());
+  }
+  else if(isInteger(rhs))
+  {
+    return makeValue(DefaultIntegerType(-rhs->As<DefaultValueType*>()->GetValue<DefaultIntegerType>()));
   }
   else
   {
-    return new DefaultValueType(-rhs->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>());
+    return broadcast(rhs, [](const auto& x) { return -x; });
   }
 }
 
 static IValueToken* UnaryOperator_Factorial(IValueToken* rhs)
 {
-  if(rhs->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>() < 0)
+  if(isInteger(rhs) && rhs->As<DefaultValueType*>()->GetValue<DefaultIntegerType>() <= kExactFactorialLimit)
   {
-    throw std::range_error("Value cannot be negative");
+    return makeValue(exactFactorial(toCount(rhs->As<DefaultValueType*>()->GetValue<DefaultIntegerType>())));
   }
 
-  return new DefaultValueType(mpfr::fac_ui(static_cast<unsigned long>(rhs->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>())));
+  return broadcast(rhs, [](const auto& x) { return factorial(x); });
 }
 #endif // __REGION__UNOPS__COMMON
 
 #ifndef __REGION__UNOPS__BITWISE
-static IValueToken* UnaryOperator_Not(IValueToken* rhs) { return new DefaultValueType(!rhs->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()); }
+static IValueToken* UnaryOperator_Not(IValueToken* rhs) { return makeValue(DefaultArithmeticType(!toArithmetic(rhs))); }
 
-static IValueToken* UnaryOperator_BitwiseOnesComplement(IValueToken* rhs)
-{
-  mpz_class tmpRhs;
-  tmpRhs.set_str(mpfr::trunc(rhs->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()).toString(), 10);
-
-  mpz_class tmpResult = ~tmpRhs;
-  return new DefaultValueType(DefaultArithmeticType(tmpResult.get_str()));
-}
+static IValueToken* UnaryOperator_BitwiseOnesComplement(IValueToken* rhs) { return makeValue(DefaultIntegerType(~toInteger(rhs))); }
 #endif // __REGION__UNOPS__BITWISE
 #endif // __REGION__UNOPS
 
 #ifndef __REGION__BINOPS
 #ifndef __REGION__BINOPS__COMPARISON
-static IValueToken* BinaryOperator_Equals(IValueToken* lhs, IValueToken* rhs) { return new DefaultValueType(DefaultArithmeticType(compare(lhs, rhs) == 0)); }
+static IValueToken* BinaryOperator_Equals(IValueToken* lhs, IValueToken* rhs) { return makeValue(DefaultArithmeticType(compare(lhs, rhs) == 0)); }
 
-static IValueToken* BinaryOperator_NotEquals(IValueToken* lhs, IValueToken* rhs) { return new DefaultValueType(DefaultArithmeticType(compare(lhs, rhs) != 0)); }
+static IValueToken* BinaryOperator_NotEquals(IValueToken* lhs, IValueToken* rhs) { return makeValue(DefaultArithmeticType(compare(lhs, rhs) != 0)); }
 
-static IValueToken* BinaryOperator_Lesser(IValueToken* lhs, IValueToken* rhs) { return new DefaultValueType(DefaultArithmeticType(compare(lhs, rhs) < 0)); }
+static IValueToken* BinaryOperator_Lesser(IValueToken* lhs, IValueToken* rhs) { return makeValue(DefaultArithmeticType(compare(lhs, rhs) < 0)); }
 
-static IValueToken* BinaryOperator_Greater(IValueToken* lhs, IValueToken* rhs) { return new DefaultValueType(DefaultArithmeticType(compare(lhs, rhs) > 0)); }
+static IValueToken* BinaryOperator_Greater(IValueToken* lhs, IValueToken* rhs) { return makeValue(DefaultArithmeticType(compare(lhs, rhs) > 0)); }
 
-static IValueToken* BinaryOperator_LesserOrEquals(IValueToken* lhs, IValueToken* rhs)
-{
-  return new DefaultValueType(DefaultArithmeticType(compare(lhs, rhs) <= 0));
-}
+static IValueToken* BinaryOperator_LesserOrEquals(IValueToken* lhs, IValueToken* rhs) { return makeValue(DefaultArithmeticType(compare(lhs, rhs) <= 0)); }
 
-static IValueToken* BinaryOperator_GreaterOrEquals(IValueToken* lhs, IValueToken* rhs)
-{
-  return new DefaultValueType(DefaultArithmeticType(compare(lhs, rhs) >= 0));
-}
+static IValueToken* BinaryOperator_GreaterOrEquals(IValueToken* lhs, IValueToken* rhs) { return makeValue(DefaultArithmeticType(compare(lhs, rhs) >= 0)); }
 
 static IValueToken* BinaryOperator_LogicalOr(IValueToken* lhs, IValueToken* rhs)
 {
-  return new DefaultValueType(lhs->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>() ||
-                              rhs->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>());
+  return makeValue(DefaultArithmeticType(toArithmetic(lhs) || toArithmetic(rhs)));
 }
 
 static IValueToken* BinaryOperator_LogicalAnd(IValueToken* lhs, IValueToken* rhs)
 {
-  return new DefaultValueType(lhs->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>() &&
-                              rhs->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>());
+  return makeValue(DefaultArithmeticType(toArithmetic(lhs) && toArithmetic(rhs)));
 }
 #endif // __REGION__BINOPS__COMPARISON
 
 #ifndef __REGION__BINOPS__COMMON
-static IValueToken* BinaryOperator_Addition(IValueToken* lhs, IValueToken* rhs)
+namespace
+{
+struct Addition
 {
-  auto lhsValue = lhs->As<DefaultValueType*>();
-  auto rhsValue = rhs->As<DefaultValueType*>();
-  if(lhs->GetType() == typeid(std::string) || rhs->GetType() == typeid(std::string))
+  using ResultType = IValueToken*;
+
+  template<class TLhs, class TRhs>
+  static constexpr bool Supports = std::is_same_v<TLhs, std::string> || std::is_same_v<TRhs, std::string> || (isNumberType<TLhs> && isNumberType<TRhs>) ||
+                                   isVectorPair<TLhs, TRhs> || isTypePair<TLhs, TRhs, boost::posix_time::time_duration, boost::posix_time::time_duration> ||
+                                   isTypePair<TLhs, TRhs, boost::posix_time::ptime, boost::posix_time::time_duration>;
+
+  static IValueToken* Apply(const DefaultIntegerType& lhs, const DefaultIntegerType& rhs) { return makeValue(DefaultIntegerType(lhs + rhs)); }
+
+  static IValueToken* Apply(const boost::posix_time::time_duration& lhs, const boost::posix_time::time_duration& rhs) { return makeValue(lhs + rhs); }
+
+  static IValueToken* Apply(const boost::posix_time::ptime& lhs, const boost::posix_time::time_duration& rhs) { return makeValue(lhs + rhs); }
+
+  template<class TLhs, class TRhs>
+  static IValueToken* Apply(const TLhs& lhs, const TRhs& rhs)
   {
-    std::string tmpString;
-    if(lhs->GetType() != typeid(std::nullptr_t))
+    if constexpr(std::is_same_v<TLhs, std::string> || std::is_same_v<TRhs, std::string>)
     {
-      tmpString += lhs->ToString();
+      return makeValue(toConcatString(lhs) + toConcatString(rhs));
     }
-
-    if(rhs->GetType() != typeid(std::nullptr_t))
+    else if constexpr(isVectorPair<TLhs, TRhs>)
     {
-      tmpString += rhs->ToString();
+      return elementwise(lhs, rhs, [](const auto& x, const auto& y) { return x + y; });
+    }
+    else
+    {
+      return makeValue(toArithmetic(lhs) + toArithmetic(rhs));
     }
-
-    return new DefaultValueType(tmpString);
-  }
-  else if(lhs->GetType() == typeid(boost::posix_time::time_duration) && rhs->GetType() == typeid(boost::posix_time::time_duration))
-  {
-    return new DefaultValueType(lhsValue->GetValue<boost::posix_time::time_duration>() + rhsValue->GetValue<boost::posix_time::time_duration>());
-  }
-  else if(lhs->GetType() == typeid(boost::posix_time::ptime) && rhs->GetType() == typeid(boost::posix_time::time_duration))
-  {
-    return new DefaultValueType(lhsValue->GetValue<boost::posix_time::ptime>() + rhsValue->GetValue<boost::posix_time::time_duration>());
-  }
-  else
-  {
-    return new DefaultValueType(lhsValue->GetValue<DefaultArithmeticType>() + rhsValue->GetValue<DefaultArithmeticType>());
   }
-}
+};
 
-static IValueToken* BinaryOperator_Subtraction(IValueToken* lhs, IValueToken* rhs)
+struct Subtraction
 {
-  auto lhsValue = lhs->As<DefaultValueType*>();
-  auto rhsValue = rhs->As<DefaultValueType*>();
-  if(lhs->GetType() == typeid(boost::posix_time::ptime) && rhs->GetType() == typeid(boost::posix_time::ptime))
-  {
-    return new DefaultValueType(lhsValue->GetValue<boost::posix_time::ptime>() - rhsValue->GetValue<boost::posix_time::ptime>());
-  }
-  else if(lhs->GetType() == typeid(boost::posix_time::time_duration) && rhs->GetType() == typeid(boost::posix_time::time_duration))
-  {
-    return new DefaultValueType(lhsValue->GetValue<boost::posix_time::time_duration>() - rhsValue->GetValue<boost::posix_time::time_duration>());
-  }
-  else if(lhs->GetType() == typeid(boost::posix_time::ptime) && rhs->GetType() == typeid(boost::posix_time::time_duration))
-  {
-    return new DefaultValueType(lhsValue->GetValue<boost::posix_time::ptime>() - rhsValue->GetValue<boost::posix_time::time_duration>());
-  }
-  else
-  {
-    return new DefaultValueType(lhsValue->GetValue<DefaultArithmeticType>() - rhsValue->GetValue<DefaultArithmeticType>());
-  }
-}
+  using ResultType = IValueToken*;
 
-static IValueToken* BinaryOperator_Multiplication(IValueToken* lhs, IValueToken* rhs)
-{
-  auto lhsValue = lhs->As<DefaultValueType*>();
-  auto rhsValue = rhs->As<DefaultValueType*>();
-  if(lhs->GetType() == typeid(std::string) && rhs->GetType() == typeid(DefaultArithmeticType))
-  {
-    return new DefaultValueType(lhsValue->GetValue<std::string>() * static_cast<std::size_t>(rhsValue->GetValue<DefaultArithmeticType>()));
-  }
-  else if(lhs->GetType() == typeid(boost::posix_time::time_duration) || rhs->GetType() == typeid(boost::posix_time::time_duration))
+  template<class TLhs, class TRhs>
+  static constexpr bool Supports = (isNumberType<TLhs> && isNumberType<TRhs>) || isVectorPair<TLhs, TRhs> ||
+                                   isTypePair<TLhs, TRhs, boost::posix_time::ptime, boost::posix_time::ptime> ||
+                                   isTypePair<TLhs, TRhs, boost::posix_time::time_duration, boost::posix_time::time_duration> ||
+                                   isTypePair<TLhs, TRhs, boost::posix_time::ptime, boost::posix_time::time_duration>;
+
+  static IValueToken* Apply(const DefaultIntegerType& lhs, const DefaultIntegerType& rhs) { return makeValue(DefaultIntegerType(lhs - rhs)); }
+
+  static IValueToken* Apply(const boost::posix_time::ptime& lhs, const boost::posix_time::ptime& rhs) { return makeValue(lhs - rhs); }
+
+  static IValueToken* Apply(const boost::posix_time::time_duration& lhs, const boost::posix_time::time_duration& rhs) { return makeValue(lhs - rhs); }
+
+  static IValueToken* Apply(const boost::posix_time::ptime& lhs, const boost::posix_time::time_duration& rhs) { return makeValue(lhs - rhs); }
+
+  template<class TLhs, class TRhs>
+  static IValueToken* Apply(const TLhs& lhs, const TRhs& rhs)
   {
-    if(lhs->GetType() == typeid(DefaultArithmeticType))
+    if constexpr(isVectorPair<TLhs, TRhs>)
     {
-      auto ticks =
-          boost::posix_time::nanoseconds(static_cast<long>(static_cast<double>(rhsValue->GetValue<boost::posix_time::time_duration>().total_nanoseconds()) *
-                                                           lhsValue->GetValue<DefaultArithmeticType>().toDouble()));
-      return new DefaultValueType(boost::posix_time::time_duration(ticks));
+      return elementwise(lhs, rhs, [](const auto& x, const auto& y) { return x - y; });
     }
     else
     {
-      auto ticks =
-          boost::posix_time::nanoseconds(static_cast<long>(static_cast<double>(lhsValue->GetValue<boost::posix_time::time_duration>().total_nanoseconds()) *
-                                                           rhsValue->GetValue<DefaultArithmeticType>().toDouble()));
-      return new DefaultValueType(boost::posix_time::time_duration(ticks));
+      return makeValue(toArithmetic(lhs) - toArithmetic(rhs));
     }
   }
-  else
-  {
-    return new DefaultValueType(lhsValue->GetValue<DefaultArithmeticType>() * rhsValue->GetValue<DefaultArithmeticType>());
-  }
-}
+};
 
-static IValueToken* BinaryOperator_Division(IValueToken* lhs, IValueToken* rhs)
+struct Multiplication
 {
-  auto lhsValue = lhs->As<DefaultValueType*>();
-  auto rhsValue = rhs->As<DefaultValueType*>();
-  if(lhs->GetType() == typeid(boost::posix_time::time_duration) && rhs->GetType() == typeid(DefaultArithmeticType))
-  {
-    auto ticks =
-        boost::posix_time::nanoseconds(static_cast<long>(static_cast<double>(lhsValue->GetValue<boost::posix_time::time_duration>().total_nanoseconds()) /
-                                                         rhsValue->GetValue<DefaultArithmeticType>().toDouble()));
-    return new DefaultValueType(boost::posix_time::time_duration(ticks));
-  }
-  else
-  {
-    return new DefaultValueType(lhsValue->GetValue<DefaultArithmeticType>() / rhsValue->GetValue<DefaultArithmeticType>());
-  }
-}
+  using ResultType = IValueToken*;
+
+  template<class TLhs, class TRhs>
+  static constexpr bool Supports = (isNumberType<TLhs> && isNumberType<TRhs>) || isVectorPair<TLhs, TRhs> ||
+                                   ((std::is_same_v<TLhs, std::string> || std::is_same_v<TLhs, boost::posix_time::time_duration>) && isNumberType<TRhs>) ||
+                                   (isNumberType<TLhs> && std::is_same_v<TRhs, boost::posix_time::time_duration>);
+
+  static IValueToken* Apply(const DefaultIntegerType& lhs, const DefaultIntegerType& rhs) { return makeValue(DefaultIntegerType(lhs * rhs)); }
+
+  template<class TLhs, class TRhs>
+  static IValueToken* Apply(const TLhs& lhs, const TRhs& rhs)
+  {
+    if constexpr(std::is_same_v<TLhs, std::string>)
+    {
+      return makeValue(lhs * static_cast<std::size_t>(toArithmetic(rhs)));
+    }
+    else if constexpr(std::is_same_v<TLhs, boost::posix_time::time_duration>)
+    {
+      return makeValue(scaleDuration(lhs, toArithmetic(rhs).toDouble()));
+    }
+    else if constexpr(std::is_same_v<TRhs, boost::posix_time::time_duration>)
+    {
+      return makeValue(scaleDuration(rhs, toArithmetic(lhs).toDouble()));
+    }
+    else if constexpr(isVectorPair<TLhs, TRhs>)
+    {
+      return elementwise(lhs, rhs, [](const auto& x, const auto& y) { return x * y; });
+    }
+    else
+    {
+      return makeValue(toArithmetic(lhs) * toArithmetic(rhs));
+    }
+  }
+};
+
+struct Division
+{
+  using ResultType = IValueToken*;
+
+  template<class TLhs, class TRhs>
+  static constexpr bool Supports =
+      ((isNumberType<TLhs> || std::is_same_v<TLhs, boost::posix_time::time_duration>) && isNumberType<TRhs>) || isVectorPair<TLhs, TRhs>;
+
+  template<class TRhs>
+  static IValueToken* Apply(const boost::posix_time::time_duration& lhs, const TRhs& rhs)
+  {
+    return makeValue(boost::posix_time::time_duration(
+        boost::posix_time::nanoseconds(static_cast<long>(static_cast<double>(lhs.total_nanoseconds()) / toArithmetic(rhs).toDouble()))));
+  }
+
+  template<class TLhs, class TRhs>
+  static IValueToken* Apply(const TLhs& lhs, const TRhs& rhs)
+  {
+    if constexpr(isVectorPair<TLhs, TRhs>)
+    {
+      return elementwise(lhs, rhs, [](const auto& x, const auto& y) { return x / y; });
+    }
+    else
+    {
+      return makeValue(toArithmetic(lhs) / toArithmetic(rhs));
+    }
+  }
+};
+} // namespace
+
+static IValueToken* BinaryOperator_Addition(IValueToken* lhs, IValueToken* rhs) { return dispatch<Addition>("addition", lhs, rhs); }
+
+static IValueToken* BinaryOperator_Subtraction(IValueToken* lhs, IValueToken* rhs) { return dispatch<Subtraction>("subtraction", lhs, rhs); }
+
+static IValueToken* BinaryOperator_Multiplication(IValueToken* lhs, IValueToken* rhs) { return dispatch<Multiplication>("multiplication", lhs, rhs); }
+
+static IValueToken* BinaryOperator_Division(IValueToken* lhs, IValueToken* rhs) { return dispatch<Division>("division", lhs, rhs); }
 
 static IValueToken* BinaryOperator_TruncatedDivision(IValueToken* lhs, IValueToken* rhs)
 {
-  return new DefaultValueType(
-      mpfr::trunc(lhs->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>() / rhs->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
+  if(isInteger(lhs) && isInteger(rhs) && sgn(rhs->As<DefaultValueType*>()->GetValue<DefaultIntegerType>()) != 0)
+  {
+    DefaultIntegerType result;
+    mpz_tdiv_q(result.get_mpz_t(),
+               lhs->As<DefaultValueType*>()->GetValue<DefaultIntegerType>().get_mpz_t(),
+               rhs->As<DefaultValueType*>()->GetValue<DefaultIntegerType>().get_mpz_t());
+    return makeValue(result);
+  }
+
+  return broadcast(lhs, rhs, [](const auto& x, const auto& y) { return mpfr::trunc(x / y); });
 }
 
 static IValueToken* BinaryOperator_Fmod(IValueToken* lhs, IValueToken* rhs)
 {
-  return new DefaultValueType(
-      mpfr::fmod(lhs->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>(), rhs->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
+  if(isInteger(lhs) && isInteger(rhs) && sgn(rhs->As<DefaultValueType*>()->GetValue<DefaultIntegerType>()) != 0)
+  {
+    DefaultIntegerType result;
+    mpz_tdiv_r(result.get_mpz_t(),
+               lhs->As<DefaultValueType*>()->GetValue<DefaultIntegerType>().get_mpz_t(),
+               rhs->As<DefaultValueType*>()->GetValue<DefaultIntegerType>().get_mpz_t());
+    return makeValue(result);
+  }
+
+  return broadcast(lhs, rhs, [](const auto& x, const auto& y) { return mpfr::fmod(x, y); });
 }
 
 static IValueToken* BinaryOperator_Remainder(IValueToken* lhs, IValueToken* rhs)
 {
-  return new DefaultValueType(
-      mpfr::remainder(lhs->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>(), rhs->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
+  return broadcast(lhs, rhs, [](const auto& x, const auto& y) { return mpfr::remainder(x, y); });
 }
 
 static IValueToken* BinaryOperator_Exponentiation(IValueToken* lhs, IValueToken* rhs)
 {
-  return new DefaultValueType(
-      mpfr::pow(lhs->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>(), rhs->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
+  return broadcast(lhs, rhs, [](const auto& x, const auto& y) { return mpfr::pow(x, y); });
 }
 #endif // __REGION__BINOPS__COMMON
 
 #ifndef __REGION__BINOPS__BITWISE
-static IValueToken* BinaryOperator_BitwiseOr(IValueToken* lhs, IValueToken* rhs)
-{
-  mpz_class tmpLhs;
-  tmpLhs.set_str(mpfr::trunc(lhs->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()).toString(), 10);
-  mpz_class tmpRhs;
-  tmpRhs.set_str(mpfr::trunc(rhs->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()).toString(), 10);
-
-  mpz_class tmpResult = tmpLhs | tmpRhs;
-  return new DefaultValueType(DefaultArithmeticType(tmpResult.get_str()));
-}
+static IValueToken* BinaryOperator_BitwiseOr(IValueToken* lhs, IValueToken* rhs) { return makeValue(DefaultIntegerType(toInteger(lhs) | toInteger(rhs))); }
 
-static IValueToken* BinaryOperator_BitwiseAnd(IValueToken* lhs, IValueToken* rhs)
-{
-  mpz_class tmpLhs;
-  tmpLhs.set_str(mpfr::trunc(lhs->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()).toString(), 10);
-  mpz_class tmpRhs;
-  tmpRhs.set_str(mpfr::trunc(rhs->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()).toString(), 10);
-
-  mpz_class tmpResult = tmpLhs & tmpRhs;
-  return new DefaultValueType(DefaultArithmeticType(tmpResult.get_str()));
-}
-
-static IValueToken* BinaryOperator_BitwiseXor(IValueToken* lhs, IValueToken* rhs)
-{
-  mpz_class tmpLhs;
-  tmpLhs.set_str(mpfr::trunc(lhs->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()).toString(), 10);
-  mpz_class tmpRhs;
-  tmpRhs.set_str(mpfr::trunc(rhs->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()).toString(), 10);
+static IValueToken* BinaryOperator_BitwiseAnd(IValueToken* lhs, IValueToken* rhs) { return makeValue(DefaultIntegerType(toInteger(lhs) & toInteger(rhs))); }
 
-  mpz_class tmpResult = tmpLhs ^ tmpRhs;
-  return new DefaultValueType(DefaultArithmeticType(tmpResult.get_str()));
-}
+static IValueToken* BinaryOperator_BitwiseXor(IValueToken* lhs, IValueToken* rhs) { return makeValue(DefaultIntegerType(toInteger(lhs) ^ toInteger(rhs))); }
 
 static IValueToken* BinaryOperator_BitwiseLeftShift(IValueToken* lhs, IValueToken* rhs)
 {
-  mpz_class tmpLhs;
-  tmpLhs.set_str(mpfr::trunc(lhs->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()).toString(), 10);
-
-  mpz_class tmpResult = tmpLhs << static_cast<mp_bitcnt_t>(rhs->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>().toULong());
-  return new DefaultValueType(DefaultArithmeticType(tmpResult.get_str()));
+  return makeValue(DefaultIntegerType(toInteger(lhs) << toCount(toInteger(rhs))));
 }
 
 static IValueToken* BinaryOperator_BitwiseRightShift(IValueToken* lhs, IValueToken* rhs)
 {
-  mpz_class tmpLhs;
-  tmpLhs.set_str(mpfr::trunc(lhs->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()).toString(), 10);
-
-  mpz_class tmpResult = tmpLhs >> static_cast<mp_bitcnt_t>(rhs->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>().toULong());
-  return new DefaultValueType(DefaultArithmeticType(tmpResult.get_str()));
+  return makeValue(DefaultIntegerType(toInteger(lhs) >> toCount(toInteger(rhs))));
 }
 #endif // __REGION__BINOPS__BITWISE
 
 #ifndef __REGION__BINOPS__SPECIAL
+namespace
+{
+struct Assignment
+{
+  using ResultType = void;
+
+  template<class T>
+  static constexpr bool Supports = true;
+
+  template<class T>
+  static void Apply(const T& value, DefaultVariableType& variable) { variable = value; }
+};
+} // namespace
+
 static IValueToken* BinaryOperator_VariableAssignment(IValueToken* lhs, IValueToken* rhs)
 {
+  auto& context                 = currentContext();
   DefaultVariableType* variable = lhs->As<DefaultVariableType*>();
   if(variable == nullptr)
   {
@@ -520,36 +927,19 @@ static IValueToken* BinaryOperator_VariableAssignment(IValueToken* lhs, IValueTo
 
   bool isInitialAssignment = !variable->IsInitialized();
 
-  auto rhsValue = rhs->As<DefaultValueType*>();
-  if(rhs->GetType() == typeid(DefaultArithmeticType))
-  {
-    (*variable) = rhsValue->GetValue<DefaultArithmeticType>();
-  }
-  else if(rhs->GetType() == typeid(boost::posix_time::ptime))
-  {
-    (*variable) = rhsValue->GetValue<boost::posix_time::ptime>();
-  }
-  else if(rhs->GetType() == typeid(boost::posix_time::time_duration))
-  {
-    (*variable) = rhsValue->GetValue<boost::posix_time::time_duration>();
-  }
-  else if(rhs->GetType() == typeid(std::string))
-  {
-    (*variable) = rhsValue->GetValue<std::string>();
-  }
-  else if(rhs->GetType() == typeid(std::nullptr_t))
-  {
-    (*variable) = rhsValue->GetValue<std::nullptr_t>();
-  }
-  else
+  const auto rhsValue = rhs->As<const DefaultValueType*>();
+  const auto handler  = UnaryDispatchTable<Assignment, DefaultValueType, DefaultTypeList, DefaultVariableType&>::Find(*rhsValue);
+  if(handler == nullptr)
   {
     throw SyntaxError((boost::format("Assignment from unsupported type: %1% (%2%)") % rhs->ToString() % rhs->GetType().name()).str());
   }
 
+  handler(*rhsValue, *variable);
+
   if(isInitialAssignment)
   {
-    auto variableIterator = defaultUninitializedVariableCache.extract(variable->GetIdentifier());
-    defaultInitializedVariableCache.insert(std::move(variableIterator));
+    auto variableIterator = context.defaultUninitializedVariableCache.extract(variable->GetIdentifier());
+    context.defaultInitializedVariableCache.insert(std::move(variableIterator));
   }
 
   return variable;
@@ -559,23 +949,17 @@ static IValueToken* BinaryOperator_VariableAssignment(IValueToken* lhs, IValueTo
 
 #ifndef __REGION__FUNCTIONS
 #ifndef __REGION__FUNCTIONS__COMMON
-static IValueToken* Function_Sgn(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType((args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>() > 0) -
-                              (args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>() < 0));
-}
-
 static IValueToken* Function_Abs(const std::vector<IValueToken*>& args)
 {
   if(args[0]->GetType() == typeid(boost::posix_time::time_duration))
   {
     const auto& tmpValue = args[0]->As<DefaultValueType*>()->GetValue<boost::posix_time::time_duration>();
     const boost::posix_time::time_duration zero;
-    return new DefaultValueType(tmpValue < zero ? -tmpValue : tmpValue);
+    return makeValue(tmpValue < zero ? -tmpValue : tmpValue);
   }
   else
   {
-    return new DefaultValueType(mpfr::abs(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
+    return broadcast(args[0], [](const auto& x) { return mpfr::abs(x); });
   }
 }
 
@@ -583,11 +967,11 @@ static IValueToken* Function_Neg(const std::vector<IValueToken*>& args)
 {
   if(args[0]->GetType() == typeid(boost::posix_time::time_duration))
   {
-    return new DefaultValueType(-args[0]->As<DefaultValueType*>()->GetValue<boost::posix_time::time_duration>());
+    return makeValue(-args[0]->As<DefaultValueType*>()->GetValue<boost::posix_time::time_duration>());
   }
   else
   {
-    return new DefaultValueType(-args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>());
+    return broadcast(args[0], [](const auto& x) { return -x; });
   }
 }
 
@@ -597,410 +981,317 @@ static IValueToken* Function_NegAbs(const std::vector<IValueToken*>& args)
   {
     const auto& tmpValue = args[0]->As<DefaultValueType*>()->GetValue<boost::posix_time::time_duration>();
     const boost::posix_time::time_duration zero;
-    return new DefaultValueType(tmpValue > zero ? -tmpValue : tmpValue);
+    return makeValue(tmpValue > zero ? -tmpValue : tmpValue);
   }
   else
   {
-    return new DefaultValueType(-mpfr::abs(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
+    return broadcast(args[0], [](const auto& x) { return -mpfr::abs(x); });
   }
 }
-
-static IValueToken* Function_Round(const std::vector<IValueToken*>& args)
-{
-  const mpfr_rnd_t tmpRndMode = (args.size() > 0u) ? strToRmode(args[1]->As<DefaultValueType*>()->GetValue<std::string>()) : mpfr::mpreal::get_default_rnd();
-  return new DefaultValueType(mpfr::rint(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>(), tmpRndMode));
-}
-
-static IValueToken* Function_RoundE(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::rint(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>(), mpfr_rnd_t::MPFR_RNDN));
-}
-
-static IValueToken* Function_RoundA(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::round(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
-
-static IValueToken* Function_Ceil(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::ceil(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
-
-static IValueToken* Function_Floor(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::floor(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
-
-static IValueToken* Function_Trunc(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::trunc(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
-
-static IValueToken* Function_Fmod(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(
-      mpfr::fmod(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>(), args[1]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
-
-static IValueToken* Function_Rem(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::remainder(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>(),
-                                              args[1]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
-
-static IValueToken* Function_Mod(const std::vector<IValueToken*>& args)
-{
-  const auto& a = args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>();
-  const auto& b = args[1]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>();
-  return new DefaultValueType(a - (mpfr::floor(a / b) * b));
-}
-
-static IValueToken* Function_Pow(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(
-      mpfr::pow(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>(), args[1]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
-
-static IValueToken* Function_Sqr(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::pow(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>(), 2));
-}
-
-static IValueToken* Function_Cb(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::pow(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>(), 3));
-}
-
-static IValueToken* Function_Root(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(
-      mpfr::pow(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>(), 1 / args[1]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
-
-static IValueToken* Function_Sqrt(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::sqrt(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
-
-static IValueToken* Function_Cbrt(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::cbrt(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
-
-static IValueToken* Function_Exp(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::exp(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
-
-static IValueToken* Function_Exp2(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::exp2(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
-
-static IValueToken* Function_Exp10(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::exp10(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
-
-static IValueToken* Function_LogN(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::log(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()) /
-                              mpfr::log(args[1]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
-
-static IValueToken* Function_Log(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::log(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
-
-static IValueToken* Function_Log2(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::log2(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
-
-static IValueToken* Function_Log10(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::log10(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
 #endif // __REGION__FUNCTIONS__COMMON
 
-#ifndef __REGION__FUNCTIONS__TRIGONOMETRY
-static IValueToken* Function_Sin(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::sin(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
-
-static IValueToken* Function_Cos(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::cos(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
-
-static IValueToken* Function_Tan(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::tan(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
-
-static IValueToken* Function_Cot(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::cot(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
-
-static IValueToken* Function_Sec(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::sec(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
-
-static IValueToken* Function_Csc(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::csc(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
-
-static IValueToken* Function_ASin(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::asin(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
-
-static IValueToken* Function_ACos(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::acos(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
-
-static IValueToken* Function_ATan(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::atan(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
-
-static IValueToken* Function_ATan2(const std::vector<IValueToken*>& args)
+#ifndef __REGION__FUNCTIONS__AGGREGATES
+// Argument values with vector arguments expanded in place.
+static std::vector<DefaultArithmeticType> toArithmeticVector(const std::vector<IValueToken*>& args)
 {
-  return new DefaultValueType(
-      mpfr::atan2(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>(), args[1]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
+  std::vector<DefaultArithmeticType> result;
+  if(std::none_of(args.cbegin(), args.cend(), isVector))
+  {
+    result.resize(args.size());
+    forEachChunk(args.size(), aggregateChunkCount(args.size()), [&args, &result](std::size_t, std::size_t begin, std::size_t end) {
+      for(std::size_t i = begin; i < end; i++)
+      {
+        result[i] = toArithmetic(args[i]);
+      }
+    });
+  }
+  else
+  {
+    for(const auto& i : args)
+    {
+      if(isVector(i))
+      {
+        const auto& elements = toVector(i).GetElements();
+        result.insert(result.end(), elements.cbegin(), elements.cend());
+      }
+      else
+      {
+        result.push_back(toArithmetic(i));
+      }
+    }
+  }
 
-static IValueToken* Function_ACot(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::acot(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
+  if(result.empty())
+  {
+    throw std::domain_error("Aggregate of an empty vector");
+  }
 
-static IValueToken* Function_ASec(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::asec(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
+  return result;
 }
 
-static IValueToken* Function_ACsc(const std::vector<IValueToken*>& args)
+// Like toArithmeticVector(), but a lone vector argument is used as is rather than copied into buffer.
+static const std::vector<DefaultArithmeticType>& toArithmeticVector(const std::vector<IValueToken*>& args, std::vector<DefaultArithmeticType>& buffer)
 {
-  return new DefaultValueType(mpfr::acsc(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
+  if(args.size() == 1u && isVector(args.front()) && !toVector(args.front()).IsEmpty())
+  {
+    return toVector(args.front()).GetElements();
+  }
 
-static IValueToken* Function_SinH(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::sinh(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
+  buffer = toArithmeticVector(args);
+  return buffer;
 }
 
-static IValueToken* Function_CosH(const std::vector<IValueToken*>& args)
+static DefaultArithmeticType mean(const std::vector<DefaultArithmeticType>& values)
 {
-  return new DefaultValueType(mpfr::cosh(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
+  std::vector<DefaultArithmeticType> partials(aggregateChunkCount(values.size()), DefaultArithmeticType(0));
+  forEachChunk(values.size(), partials.size(), [&values, &partials](std::size_t chunk, std::size_t begin, std::size_t end) {
+    for(std::size_t i = begin; i < end; i++)
+    {
+      partials[chunk] += values[i];
+    }
+  });
 
-static IValueToken* Function_TanH(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::tanh(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
+  DefaultArithmeticType result = 0;
+  for(const auto& i : partials)
+  {
+    result += i;
+  }
 
-static IValueToken* Function_CotH(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::coth(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
+  return result / static_cast<DefaultArithmeticType>(values.size());
 }
 
-static IValueToken* Function_SecH(const std::vector<IValueToken*>& args)
+static RunningVariance<DefaultArithmeticType> variance(const std::vector<DefaultArithmeticType>& values)
 {
-  return new DefaultValueType(mpfr::sech(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
+  std::vector<RunningVariance<DefaultArithmeticType>> partials(aggregateChunkCount(values.size()));
+  forEachChunk(values.size(), partials.size(), [&values, &partials](std::size_t chunk, std::size_t begin, std::size_t end) {
+    for(std::size_t i = begin; i < end; i++)
+    {
+      partials[chunk].Push(values[i]);
+    }
+  });
 
-static IValueToken* Function_CscH(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::csch(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
+  for(std::size_t i = 1u; i < partials.size(); i++)
+  {
+    partials.front().Merge(partials[i]);
+  }
 
-static IValueToken* Function_ASinH(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::asinh(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
+  return partials.front();
 }
 
-static IValueToken* Function_ACosH(const std::vector<IValueToken*>& args)
+struct ArithmeticHash
 {
-  return new DefaultValueType(mpfr::acosh(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
+  std::size_t operator()(const DefaultArithmeticType& value) const
+  {
+    const auto source = value.mpfr_srcptr();
+    if(mpfr_regular_p(source) == 0)
+    {
+      return mpfr_nan_p(source) != 0 ? 1u : (mpfr_inf_p(source) != 0 ? (mpfr_signbit(source) != 0 ? 2u : 3u) : 0u);
+    }
 
-static IValueToken* Function_ATanH(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::atanh(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
+    const auto topLimb = source->_mpfr_d[(mpfr_get_prec(source) - 1) / GMP_NUMB_BITS];
+    return std::hash<mp_limb_t>()(topLimb) ^ (std::hash<mpfr_exp_t>()(mpfr_get_exp(source)) * 31u) ^ (mpfr_signbit(source) != 0 ? 1u : 0u);
+  }
+};
+#endif // __REGION__FUNCTIONS__AGGREGATES
 
-static IValueToken* Function_ACotH(const std::vector<IValueToken*>& args)
+#ifndef __REGION__FUNCTIONS__COMBINATORICS
+static IValueToken* Function_Binom(const std::vector<IValueToken*>& args)
 {
-  return new DefaultValueType(mpfr::acoth(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
+  if(isInteger(args[0]) && isInteger(args[1]))
+  {
+    const auto& n = args[0]->As<DefaultValueType*>()->GetValue<DefaultIntegerType>();
+    const auto& k = args[1]->As<DefaultValueType*>()->GetValue<DefaultIntegerType>();
+    if(sgn(k) < 0 || (sgn(n) >= 0 && k > n))
+    {
+      return makeValue(DefaultIntegerType(0));
+    }
 
-static IValueToken* Function_ASecH(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::asech(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
-}
+    // The cost of the exact value grows with the smaller of k and n - k, which is what the limit applies to.
+    const DefaultIntegerType rest     = n - k;
+    const DefaultIntegerType& smaller = sgn(n) >= 0 && rest < k ? rest : k;
+    if(smaller <= kExactFactorialLimit)
+    {
+      return makeValue(exactBinomial(n, smaller.get_ui()));
+    }
+  }
 
-static IValueToken* Function_ACscH(const std::vector<IValueToken*>& args)
-{
-  return new DefaultValueType(mpfr::acsch(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()));
+  return broadcast(args[0], args[1], [](const auto& x, const auto& y) { return binomial(x, y); });
 }
-#endif // __REGION__FUNCTIONS__TRIGONOMETRY
 
-#ifndef __REGION__FUNCTIONS__AGGREGATES
-static IValueToken* Function_Min(const std::vector<IValueToken*>& args)
+static IValueToken* Function_Multinom(const std::vector<IValueToken*>& args)
 {
-  auto result = std::numeric_limits<DefaultArithmeticType>::max();
-  for(const auto& i : args)
+  if(std::all_of(args.cbegin(), args.cend(), isInteger))
   {
-    auto tmpValue = i->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>();
-    if(tmpValue < result)
+    std::vector<unsigned long> counts;
+    counts.reserve(args.size());
+    DefaultIntegerType total = 0;
+    for(const auto& i : args)
     {
-      result = tmpValue;
+      const auto& value = i->As<DefaultValueType*>()->GetValue<DefaultIntegerType>();
+      counts.push_back(toCount(value));
+      total += value;
     }
-  }
 
-  return new DefaultValueType(result);
-}
-static IValueToken* Function_Max(const std::vector<IValueToken*>& args)
-{
-  auto result = std::numeric_limits<DefaultArithmeticType>::min();
-  for(const auto& i : args)
-  {
-    auto tmpValue = i->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>();
-    if(tmpValue > result)
+    if(total <= kExactFactorialLimit)
     {
-      result = tmpValue;
+      return makeValue(exactMultinomial(counts));
     }
   }
 
-  return new DefaultValueType(result);
+  return makeValue(multinomial(toArithmeticVector(args)));
 }
+#endif // __REGION__FUNCTIONS__COMBINATORICS
+
+#ifndef __REGION__FUNCTIONS__SERIES
+// Terms per chunk of a series. Chunk partials are combined in chunk order, so the result does not depend on how many threads evaluated them.
+static constexpr std::size_t kSeriesChunkSize = 1u << 12u;
+// Chunks evaluated between folds of their partials into the result, which bounds the partials kept for long series.
+static constexpr std::size_t kSeriesBatchSize = 1u << 10u;
 
-static IValueToken* Function_Mean(const std::vector<IValueToken*>& args)
+// Fallback for bodies the compiler does not handle: evaluates body with an ExpressionParser for each index, serially. The bound variable shadows any
+// global of the same name while the series runs.
+template<class TCombine>
+static DefaultArithmeticType evaluateParsedSeries(const std::string& body,
+                                                  const std::string& identifier,
+                                                  const DefaultArithmeticType& start,
+                                                  std::size_t count,
+                                                  const DefaultArithmeticType& identity,
+                                                  const TCombine& combine)
 {
-  DefaultArithmeticType result = 0;
-  for(const auto& i : args)
+  auto& context  = currentContext();
+  auto variables = context.defaultVariables;
+  DefaultVariableType index(identifier, start);
+  variables[identifier] = &index;
+
+  ExpressionParser parser;
+  parser.SetOnParseNumberCallback(context.defaultNumberConverter);
+  parser.SetOnParseStringCallback(context.defaultStringConverter);
+  parser.SetOnUnknownIdentifierCallback(context.defaultUnknownIdentifierCallback);
+  parser.SetJuxtapositionOperator(context.defaultJuxtapositionOperator.get());
+  parser.SetUnaryOperators(&context.defaultUnaryOperators);
+  parser.SetBinaryOperators(&context.defaultBinaryOperators);
+  parser.SetFunctions(&context.defaultFunctions);
+  parser.SetVariables(&variables);
+
+  ValueArena arena;
+  const ValueArena::Scope arenaScope(arena);
+  DefaultArithmeticType result = identity;
+  for(std::size_t i = 0u; i < count; i++)
   {
-    result += i->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>();
+    index = start + static_cast<unsigned long>(i);
+    combine(result, toArithmetic(parser.Evaluate(body)));
+    arena.Release();
   }
 
-  return new DefaultValueType(result / static_cast<DefaultArithmeticType>(args.size()));
+  return result;
 }
 
-static IValueToken* Function_Median(const std::vector<IValueToken*>& args)
+// Evaluates the expression string args[0] once per integer step of the variable named args[1] from args[2] through args[3], folding the terms into
+// identity with combine. The expression is compiled once and the terms are never materialized as arguments.
+template<class TCombine>
+static DefaultArithmeticType evaluateSeries(const std::vector<IValueToken*>& args, const DefaultArithmeticType& identity, const TCombine& combine)
 {
-  auto tmpArgs = args;
-  std::sort(tmpArgs.begin(), tmpArgs.end(), GreaterComparer());
-  std::size_t middle = tmpArgs.size() / 2u;
-  if(tmpArgs.size() % 2 == 0)
-  {
-    return new DefaultValueType((tmpArgs[middle - 1u]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>() +
-                                 tmpArgs[middle]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()) /
-                                2);
-  }
-  else
+  const auto& body       = args[0]->As<const DefaultValueType*>()->GetValue<std::string>();
+  const auto& identifier = args[1]->As<const DefaultValueType*>()->GetValue<std::string>();
+  const auto start       = toArithmetic(args[2]);
+  const auto span        = mpfr::floor(toArithmetic(args[3]) - start);
+  if(!mpfr::isfinite(start) || !mpfr::isfinite(span) || span >= DefaultArithmeticType(std::numeric_limits<std::size_t>::max()))
   {
-    return new DefaultValueType(tmpArgs[middle]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>());
+    throw std::domain_error("Series bounds must be finite");
   }
-}
 
-static IValueToken* Function_Quartile_Lower(const std::vector<IValueToken*>& args)
-{
-  auto tmpArgs = args;
-  std::sort(tmpArgs.begin(), tmpArgs.end(), GreaterComparer());
-  std::size_t middle = tmpArgs.size() / 4u;
-  if(middle % 2 == 0)
+  const std::size_t count = span >= 0 ? static_cast<std::size_t>(span.toULong()) + 1u : 0u;
+  const auto expression   = compileCached(body);
+  if(expression == nullptr)
   {
-    return new DefaultValueType((tmpArgs[middle - 1u]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>() +
-                                 tmpArgs[middle]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()) /
-                                2);
+    return evaluateParsedSeries(body, identifier, start, count, identity, combine);
   }
-  else
+  else if(expression->GetStatementCount() != 1u)
   {
-    return new DefaultValueType(tmpArgs[middle]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>());
+    throw SyntaxError("Invalid series expression: " + body);
   }
-}
 
-static IValueToken* Function_Quartile_Upper(const std::vector<IValueToken*>& args)
-{
-  auto tmpArgs = args;
-  std::sort(tmpArgs.begin(), tmpArgs.end(), GreaterComparer());
-  std::size_t middle   = tmpArgs.size() / 2u;
-  std::size_t q        = middle / 2u;
-  std::size_t tmpIndex = (middle + (tmpArgs.size() % 2 == 0 ? 0 : 1)) + q;
-  if(middle % 2 == 0)
-  {
-    return new DefaultValueType((tmpArgs[tmpIndex - 1u]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>() +
-                                 tmpArgs[tmpIndex]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()) /
-                                2);
-  }
-  else
+  auto& context                 = currentContext();
+  const std::size_t chunkCount  = (count + kSeriesChunkSize - 1u) / kSeriesChunkSize;
+  const std::size_t threadCount = expression->IsParallelSafe(identifier) && !WorkerScope::IsActive() ? std::max(1u, context.options.agg_threads) : 1u;
+  const auto precision          = mpfr::mpreal::get_default_prec();
+  const auto roundingMode       = mpfr::mpreal::get_default_rnd();
+
+  DefaultArithmeticType result = identity;
+  std::vector<DefaultArithmeticType> partials;
+  for(std::size_t batch = 0u; batch < chunkCount; batch += kSeriesBatchSize)
   {
-    return new DefaultValueType(tmpArgs[tmpIndex]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>());
-  }
-}
+    const std::size_t batchEnd = std::min(chunkCount, batch + kSeriesBatchSize);
+    partials.assign(batchEnd - batch, identity);
+    std::atomic<std::size_t> nextChunk {batch};
+    const auto run = [&]() {
+      const KalkContext::Scope scope(context);
+      std::optional<WorkerScope> workerScope;
+      if(threadCount > 1u)
+      {
+        workerScope.emplace();
+      }
 
-static IValueToken* Function_Mode(const std::vector<IValueToken*>& args)
-{
-  auto tmpArgs = args;
-  std::sort(tmpArgs.begin(), tmpArgs.end(), GreaterComparer());
+      mpfr::mpreal::set_default_prec(precision);
+      mpfr::mpreal::set_default_rnd(roundingMode);
 
-  auto current             = tmpArgs.front();
-  std::size_t currentCount = 1u;
-  auto mode                = current;
-  std::size_t modeCount    = currentCount;
+      ValueArena arena;
+      const ValueArena::Scope arenaScope(arena);
+      CompiledExpression::TemporaryCollection temporaries;
+      DefaultValueType index(start);
+      const CompiledExpression::Binding binding {identifier, &index};
+      try
+      {
+        for(std::size_t chunk = nextChunk++; chunk < batchEnd; chunk = nextChunk++)
+        {
+          const std::size_t end = std::min(count, (chunk + 1u) * kSeriesChunkSize);
+          for(std::size_t i = chunk * kSeriesChunkSize; i < end; i++)
+          {
+            index = start + static_cast<unsigned long>(i);
+            combine(partials[chunk - batch], toArithmetic(expression->Evaluate(0u, temporaries, &binding)));
+            temporaries.clear();
+            arena.Release();
+          }
+        }
+      }
+      catch(...)
+      {
+        nextChunk = batchEnd;
+        throw;
+      }
+    };
 
-  for(std::size_t i = 1u; i < tmpArgs.size(); i++)
-  {
-    if(tmpArgs[i]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>() == current->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>())
+    std::vector<std::future<void>> workers;
+    for(std::size_t i = 1u; i < std::min(threadCount, partials.size()); i++)
     {
-      currentCount++;
+      workers.push_back(std::async(std::launch::async, run));
     }
-    else
+
+    run();
+    for(auto& i : workers)
     {
-      if(currentCount > modeCount)
-      {
-        modeCount = currentCount;
-        mode      = current;
-      }
+      i.get();
+    }
 
-      currentCount = 1u;
-      current      = tmpArgs[i];
+    for(const auto& i : partials)
+    {
+      combine(result, i);
     }
   }
 
-  return new DefaultValueType(mode->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>());
+  return result;
 }
 
-static IValueToken* Function_StdDev(const std::vector<IValueToken*>& args)
+static IValueToken* Function_Sum(const std::vector<IValueToken*>& args)
 {
-  DefaultArithmeticType result = 0;
-  std::unique_ptr<IValueToken> tmpMean(Function_Mean(args));
-
-  for(const auto& i : args)
-  {
-    result +=
-        mpfr::pow(i->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>() - tmpMean.get()->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>(), 2);
-  }
-
-  return new DefaultValueType(mpfr::sqrt(result / static_cast<DefaultArithmeticType>(args.size())));
+  return makeValue(evaluateSeries(args, DefaultArithmeticType(0), [](DefaultArithmeticType& result, const DefaultArithmeticType& value) { result += value; }));
 }
-#endif // __REGION__FUNCTIONS__AGGREGATES
-
-#ifndef __REGION__FUNCTIONS__STRING
-static IValueToken* Function_Str(const std::vector<IValueToken*>& args) { return new DefaultValueType(args[0]->ToString()); }
 
-static IValueToken* Function_StrLen(const std::vector<IValueToken*>& args)
+static IValueToken* Function_Prod(const std::vector<IValueToken*>& args)
 {
-  return new DefaultValueType(static_cast<DefaultArithmeticType>(args[0]->As<DefaultValueType*>()->GetValue<std::string>().length()));
+  return makeValue(evaluateSeries(args, DefaultArithmeticType(1), [](DefaultArithmeticType& result, const DefaultArithmeticType& value) { result *= value; }));
 }
-#endif // #ifndef __REGION__FUNCTIONS__STRING
+#endif // __REGION__FUNCTIONS__SERIES
 
 #ifndef __REGION__FUNCTIONS__DATE_TIME
 static IValueToken* Function_Date(const std::vector<IValueToken*>& args)
@@ -1008,7 +1299,7 @@ static IValueToken* Function_Date(const std::vector<IValueToken*>& args)
   const auto now = boost::posix_time::second_clock::local_time();
   if(args.size() == 0u)
   {
-    return new DefaultValueType(now);
+    return makeValue(now);
   }
   else
   {
@@ -1027,13 +1318,13 @@ static IValueToken* Function_Date(const std::vector<IValueToken*>& args)
       dateTimeString = (boost::format("%1% %2%") % formatDateTime(now, "%Y-%m-%d") % dateTimeString).str();
     }
 
-    return new DefaultValueType(boost::posix_time::time_from_string(dateTimeString));
+    return makeValue(boost::posix_time::time_from_string(dateTimeString));
   }
 }
 
 static IValueToken* Function_Dur(const std::vector<IValueToken*>& args)
 {
-  return new DefaultValueType(boost::posix_time::duration_from_string(args[0]->As<DefaultValueType*>()->GetValue<std::string>()));
+  return makeValue(boost::posix_time::duration_from_string(args[0]->As<DefaultValueType*>()->GetValue<std::string>()));
 }
 #endif // __REGION__FUNCTIONS__DATE_TIME
 
@@ -1042,24 +1333,24 @@ static IValueToken* Function_Random(const std::vector<IValueToken*>& args)
 {
   if(args.size() == 0u)
   {
-    return new DefaultValueType(mpfr::random());
+    return makeValue(mpfr::random());
   }
   else if(args.size() == 1u)
   {
-    return new DefaultValueType(mpfr::random() * args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>());
+    return makeValue(mpfr::random() * toArithmetic(args[0]));
   }
   else
   {
-    const auto diff = args[1]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>() - args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>();
-    return new DefaultValueType(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>() + (mpfr::random() * diff));
+    const auto diff = toArithmetic(args[1]) - toArithmetic(args[0]);
+    return makeValue(toArithmetic(args[0]) + (mpfr::random() * diff));
   }
 }
 
 static IValueToken* Function_BConv(const std::vector<IValueToken*>& args)
 {
-  return new DefaultValueType(mpfr::mpreal(args[0]->As<DefaultValueType*>()->GetValue<std::string>(),
-                                           mpfr::mpreal::get_default_prec(),
-                                           static_cast<int>(mpfr::trunc(args[1]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>()).toLong())));
+  return makeValue(mpfr::mpreal(args[0]->As<DefaultValueType*>()->GetValue<std::string>(),
+                                mpfr::mpreal::get_default_prec(),
+                                static_cast<int>(mpfr::trunc(toArithmetic(args[1])).toLong())));
 }
 #endif // __REGION__FUNCTIONS__MISC
 
@@ -1068,356 +1359,252 @@ static IValueToken* Function_Ans(const std::vector<IValueToken*>& args)
 {
   if(args.empty())
   {
-    return new DefaultValueType(*ans());
+    return makeValue(*ans());
   }
 
-  int index = static_cast<int>(args[0]->As<DefaultValueType*>()->GetValue<DefaultArithmeticType>());
-  return new DefaultValueType(*ans(index));
+  int index = static_cast<int>(toArithmetic(args[0]));
+  return makeValue(*ans(index));
 }
 
 static IValueToken* Function_Del(const std::vector<IValueToken*>& args)
 {
+  const auto& context          = currentContext();
   const std::string identifier = args[0]->As<DefaultValueType*>()->GetValue<std::string>();
-  auto iter                    = defaultInitializedVariableCache.find(identifier);
-  if(iter == defaultInitializedVariableCache.end())
+  if(context.defaultVariables.count(identifier) == 0u)
   {
-    iter = defaultUninitializedVariableCache.find(identifier);
-    if(iter == defaultUninitializedVariableCache.end())
+    materializeVariable(identifier);
+  }
+
+  auto iter = context.defaultInitializedVariableCache.find(identifier);
+  if(iter == context.defaultInitializedVariableCache.end())
+  {
+    iter = context.defaultUninitializedVariableCache.find(identifier);
+    if(iter == context.defaultUninitializedVariableCache.end())
     {
       throw SyntaxError("Deletion of nonexistent variable: " + identifier);
     }
   }
 
-  auto result = new DefaultValueType(*dynamic_cast<DefaultValueType*>(iter->second.get()));
+  auto result = makeValue(*dynamic_cast<DefaultValueType*>(iter->second.get()));
   removeVariable(identifier);
   return result;
 }
 #endif // __REGION__FUNCTIONS__SPECIAL
 
-static ExpressionParser chemicalExpressionParser;
-
 static IValueToken* Function_MolarMass(const std::vector<IValueToken*>& args)
 {
-  return new DefaultValueType(chemicalExpressionParser.Evaluate(makeCompoundString(args[0]->As<DefaultValueType*>()->GetValue<std::string>()))
-                                  ->As<ChemValueType*>()
-                                  ->GetValue<ChemArithmeticType>());
+  auto& context = currentContext();
+  return makeValue(context.chemicalExpressionParser.Evaluate(makeCompoundString(args[0]->As<DefaultValueType*>()->GetValue<std::string>()))
+                       ->As<ChemValueType*>()
+                       ->GetValue<ChemArithmeticType>());
 }
 #endif // __REGION__FUNCTIONS
 
-static std::unique_ptr<BinaryOperatorToken> juxtapositionOperator;
+template<>
+struct NumericTraits<DefaultArithmeticType>
+{
+  using ValueType  = DefaultValueType;
+  using VectorType = DefaultVectorType;
+  using ModeHash   = ArithmeticHash;
+
+  template<class TValue>
+  static IValueToken* MakeValue(TValue&& value)
+  {
+    return makeValue(std::forward<TValue>(value));
+  }
+
+  static IValueToken* MakeCount(std::size_t count) { return makeValue(DefaultIntegerType(static_cast<unsigned long>(count))); }
+
+  static DefaultArithmeticType ToArithmetic(const IValueToken* value) { return toArithmetic(value); }
 
-void InitDefaultExpressionParser(ExpressionParser& instance)
+  static bool IsVector(const IValueToken* value) { return isVector(value); }
+
+  static const DefaultVectorType& ToVector(const IValueToken* value) { return toVector(value); }
+
+  template<class TFunction>
+  static IValueToken* Broadcast(const IValueToken* value, const TFunction& function)
+  {
+    return broadcast(value, function);
+  }
+
+  template<class TFunction>
+  static IValueToken* Broadcast(const IValueToken* lhs, const IValueToken* rhs, const TFunction& function)
+  {
+    return broadcast(lhs, rhs, function);
+  }
+
+  static std::vector<DefaultArithmeticType> ToArithmeticVector(const std::vector<IValueToken*>& args) { return toArithmeticVector(args); }
+
+  static const std::vector<DefaultArithmeticType>& ToArithmeticVector(const std::vector<IValueToken*>& args, std::vector<DefaultArithmeticType>& buffer)
+  {
+    return toArithmeticVector(args, buffer);
+  }
+
+  static DefaultArithmeticType Min(const std::vector<DefaultArithmeticType>& values) { return *std::min_element(values.cbegin(), values.cend()); }
+
+  static DefaultArithmeticType Max(const std::vector<DefaultArithmeticType>& values) { return *std::max_element(values.cbegin(), values.cend()); }
+
+  static DefaultArithmeticType Mean(const std::vector<DefaultArithmeticType>& values) { return mean(values); }
+
+  static RunningVariance<DefaultArithmeticType> Variance(const std::vector<DefaultArithmeticType>& values) { return variance(values); }
+
+  // Constants are generated on first use, at the precision in effect then.
+  static void AddConstant(VariableGeneratorType generator, const std::string& identifier, const char* title, const char* description)
+  {
+    addLazyVariable(generator, identifier, title, description);
+  }
+
+  static constexpr UnaryOperatorCallbackType UnaryOperator_Not                   = ::UnaryOperator_Not;
+  static constexpr UnaryOperatorCallbackType UnaryOperator_Plus                  = ::UnaryOperator_Plus;
+  static constexpr UnaryOperatorCallbackType UnaryOperator_Minus                 = ::UnaryOperator_Minus;
+  static constexpr UnaryOperatorCallbackType UnaryOperator_Factorial             = ::UnaryOperator_Factorial;
+  static constexpr UnaryOperatorCallbackType UnaryOperator_BitwiseOnesComplement = ::UnaryOperator_BitwiseOnesComplement;
+
+  static constexpr BinaryOperatorCallbackType BinaryOperator_Equals             = ::BinaryOperator_Equals;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_NotEquals          = ::BinaryOperator_NotEquals;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_Lesser             = ::BinaryOperator_Lesser;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_Greater            = ::BinaryOperator_Greater;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_LesserOrEquals     = ::BinaryOperator_LesserOrEquals;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_GreaterOrEquals    = ::BinaryOperator_GreaterOrEquals;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_LogicalOr          = ::BinaryOperator_LogicalOr;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_LogicalAnd         = ::BinaryOperator_LogicalAnd;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_Addition           = ::BinaryOperator_Addition;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_Subtraction        = ::BinaryOperator_Subtraction;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_Multiplication     = ::BinaryOperator_Multiplication;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_Division           = ::BinaryOperator_Division;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_TruncatedDivision  = ::BinaryOperator_TruncatedDivision;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_Fmod               = ::BinaryOperator_Fmod;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_Remainder          = ::BinaryOperator_Remainder;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_Exponentiation     = ::BinaryOperator_Exponentiation;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_BitwiseOr          = ::BinaryOperator_BitwiseOr;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_BitwiseAnd         = ::BinaryOperator_BitwiseAnd;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_BitwiseXor         = ::BinaryOperator_BitwiseXor;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_BitwiseLeftShift   = ::BinaryOperator_BitwiseLeftShift;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_BitwiseRightShift  = ::BinaryOperator_BitwiseRightShift;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_VariableAssignment = ::BinaryOperator_VariableAssignment;
+
+  static constexpr FunctionCallbackType Function_Abs      = ::Function_Abs;
+  static constexpr FunctionCallbackType Function_Neg      = ::Function_Neg;
+  static constexpr FunctionCallbackType Function_NegAbs   = ::Function_NegAbs;
+  static constexpr FunctionCallbackType Function_Sqrt     = ::Function_Sqrt<DefaultArithmeticType>;
+  static constexpr FunctionCallbackType Function_Binom    = ::Function_Binom;
+  static constexpr FunctionCallbackType Function_Multinom = ::Function_Multinom;
+};
+
+void InitDefaultExpressionParser(ExpressionParser& instance, KalkContext& context)
 {
-  if(options.jpo_precedence != 0)
+  const KalkContext::Scope scope(context);
+  if(context.options.jpo_precedence != 0)
   {
-    juxtapositionOperator = std::make_unique<BinaryOperatorToken>("*", BinaryOperator_Multiplication, 6 + options.jpo_precedence, Associativity::Left);
+    context.defaultJuxtapositionOperator =
+        std::make_unique<BinaryOperatorToken>("*", BinaryOperator_Multiplication, 6 + context.options.jpo_precedence, Associativity::Left);
   }
 
   instance.SetOnParseNumberCallback(numberConverter);
   instance.SetOnParseStringCallback(stringConverter);
   instance.SetOnUnknownIdentifierCallback(addNewVariable);
-  instance.SetJuxtapositionOperator(juxtapositionOperator.get());
-
-  instance.SetUnaryOperators(&defaultUnaryOperators);
-  instance.SetBinaryOperators(&defaultBinaryOperators);
-  instance.SetFunctions(&defaultFunctions);
-  instance.SetVariables(&defaultVariables);
-
-  addUnaryOperator(UnaryOperator_Not, '!', 9, Associativity::Right, "Not", "!x");
-  unaryOperatorInfoMap.push_back(std::make_tuple(nullptr, "", ""));
-  addUnaryOperator(UnaryOperator_Plus, '+', 9, Associativity::Right, "Unary plus", "+x");
-  addUnaryOperator(UnaryOperator_Minus, '-', 9, Associativity::Right, "Unary minus", "-x");
-  addUnaryOperator(UnaryOperator_Factorial, ':', 9, Associativity::Right, "Factorial", ":x = x!");
-  addUnaryOperator(UnaryOperator_BitwiseOnesComplement, '~', 9, Associativity::Right, "One\'s complement", "Invert bits");
-
-  addBinaryOperator(BinaryOperator_Equals, "==", 3, Associativity::Left, "Equals", "x == y");
-  addBinaryOperator(BinaryOperator_NotEquals, "!=", 3, Associativity::Left, "Not equals", "x != y");
-  addBinaryOperator(BinaryOperator_Lesser, "<", 3, Associativity::Left, "Lesser", "x < y");
-  addBinaryOperator(BinaryOperator_Greater, ">", 3, Associativity::Left, "Greater", "x > y");
-  addBinaryOperator(BinaryOperator_LesserOrEquals, "<=", 3, Associativity::Left, "Lesser or equal", "x <= y");
-  addBinaryOperator(BinaryOperator_GreaterOrEquals, ">=", 3, Associativity::Left, "Greater or equal", "x >= y");
-  binaryOperatorInfoMap.push_back(std::make_tuple(nullptr, "", ""));
-
-  addBinaryOperator(BinaryOperator_LogicalOr, "||", 1, Associativity::Left, "Logical OR", "x || y");
-  addBinaryOperator(BinaryOperator_LogicalAnd, "&&", 1, Associativity::Left, "Logical AND", "x && y");
-  binaryOperatorInfoMap.push_back(std::make_tuple(nullptr, "", ""));
-
-  addBinaryOperator(BinaryOperator_Addition, "+", 4, Associativity::Left, "Addition", "x + y");
-  addBinaryOperator(BinaryOperator_Subtraction, "-", 4, Associativity::Left, "Subtraction", "x - y");
-  addBinaryOperator(BinaryOperator_Multiplication, "*", 6, Associativity::Left, "Multiplication", "x * y");
-  addBinaryOperator(BinaryOperator_Division, "/", 6, Associativity::Left, "Division", "x / y");
-  addBinaryOperator(BinaryOperator_TruncatedDivision,
-                    "//",
-                    6,
-                    Associativity::Left,
-                    "Truncated division",
-                    "Division with the quotient\'s fractional part truncated");
-  addBinaryOperator(BinaryOperator_Fmod, "%", 6, Associativity::Left, "Floating point modulo", "Returns the remainder of x / y (Using truncation)");
-  addBinaryOperator(BinaryOperator_Remainder, "%%", 6, Associativity::Left, "Remainder", "Returns the remainder of x / y (Using round to nearest)");
-  addBinaryOperator(BinaryOperator_Exponentiation, "**", 8, Associativity::Right, "Power", "Returns x to the power of y");
-  binaryOperatorInfoMap.push_back(std::make_tuple(nullptr, "", ""));
-
-  addBinaryOperator(BinaryOperator_BitwiseOr, "|", 2, Associativity::Left, "Bitwise OR", "x | y");
-  addBinaryOperator(BinaryOperator_BitwiseAnd, "&", 2, Associativity::Left, "Bitwise AND", "x & y");
-  addBinaryOperator(BinaryOperator_BitwiseXor, "^", 2, Associativity::Left, "Bitwise XOR", "x ^ y");
-  addBinaryOperator(BinaryOperator_BitwiseLeftShift, "<<", 2, Associativity::Left, "Bitwise left shift", "Shift bits n steps to the left");
-  addBinaryOperator(BinaryOperator_BitwiseRightShift, ">>", 2, Associativity::Left, "Bitwise right shift", "Shift bits n steps to the right");
-  binaryOperatorInfoMap.push_back(std::make_tuple(nullptr, "", ""));
-
-  addBinaryOperator(BinaryOperator_VariableAssignment, "=", 10, Associativity::Right, "Assignment", "Assigns variable");
+  instance.SetJuxtapositionOperator(context.defaultJuxtapositionOperator.get());
+
+  context.defaultNumberConverter           = numberConverter;
+  context.defaultStringConverter           = stringConverter;
+  context.defaultUnknownIdentifierCallback = addNewVariable;
+  context.defaultJuxtapositionCallback     = BinaryOperator_Multiplication;
+
+  instance.SetUnaryOperators(&context.defaultUnaryOperators);
+  instance.SetBinaryOperators(&context.defaultBinaryOperators);
+  instance.SetFunctions(&context.defaultFunctions);
+  instance.SetVariables(&context.defaultVariables);
+
+  addNumericOperators<DefaultArithmeticType>();
 
   addFunction(Function_Ans, "ans", 0u, 1u, "Answer", "Returns the result at the index specified by argument");
   addFunction(Function_Del, "del", 1u, 1u, "Delete", "Delete and return the variable that matches the argument");
   addFunction(Function_BConv, "bconv", 2u, 2u, "Base conversion", "Convert value specified by argument x(str) from the base specified by y(num)");
-  functionInfoMap.push_back(std::make_tuple(nullptr, "", ""));
-
-  addFunction(Function_Sgn, "sgn", 1u, 1u, "Sign", "Returns the sign (-1, 0, 1)");
-  addFunction(Function_Abs, "abs", 1u, 1u, "Absolute value", "Returns the absolute value");
-  addFunction(Function_Neg, "neg", 1u, 1u, "Negate", "Returns the negated value");
-  addFunction(Function_NegAbs, "negabs", 1u, 1u, "Negate absolute value", "Returns the negated absolute value");
-  addFunction(Function_Round, "round", 1u, 2u, "Round", "Round a value according to second argument or the default rounding mode");
-  addFunction(Function_RoundE, "rounde", 1u, 1u, "Round even", "Round a value with halfway cases to nearest even number");
-  addFunction(Function_RoundA, "rounda", 1u, 1u, "Round away", "Round a value with halfway cases away from zero");
-  addFunction(Function_Ceil, "ceil", 1u, 1u, "Ceil", "Round a value towards higher or equal number");
-  addFunction(Function_Floor, "floor", 1u, 1u, "Floor", "Round a value towards lower or equal number");
-  addFunction(Function_Trunc, "trunc", 1u, 1u, "Truncation", "Truncates the fractional part (Round towards zero)");
-  functionInfoMap.push_back(std::make_tuple(nullptr, "", ""));
-
-  addFunction(Function_Fmod, "math.fmod", 2u, 2u, "Floating point modulo", "Returns the remainder of x / y (Using truncation)");
-  addFunction(Function_Rem, "math.rem", 2u, 2u, "Remainder", "Returns the remainder of x / y (Using round to nearest)");
-  addFunction(Function_Mod, "math.mod", 2u, 2u, "Modulo", "Returns modulo of x / y");
-  addFunction(Function_Pow, "math.pow", 2u, 2u, "Power", "Returns x to the power of y");
-  addFunction(Function_Sqr, "math.sqr", 1u, 1u, "Square", "Returns x to the power of 2");
-  addFunction(Function_Cb, "math.cb", 1u, 1u, "Cube", "Returns x to the power of 3");
-  addFunction(Function_Root, "math.root", 2u, 2u, "Root", "Returns nth root of x");
-  addFunction(Function_Sqrt, "math.sqrt", 1u, 1u, "Square root", "Returns square root of x");
-  addFunction(Function_Cbrt, "math.cbrt", 1u, 1u, "Cubic root", "Returns cubic root of x");
-  functionInfoMap.push_back(std::make_tuple(nullptr, "", ""));
-
-  addFunction(Function_Exp, "math.exp", 1u, 1u, "Natural exponent", "Returns e to the power of x");
-  addFunction(Function_Exp2, "math.exp2", 1u, 1u, "Binary exponent", "Returns 2 to the power of x");
-  addFunction(Function_Exp10, "math.exp10", 1u, 1u, "Decimal exponent", "Returns 10 to the power of x");
-  addFunction(Function_LogN, "math.logn", 1u, 1u, "Logarithm", "Returns nth logarithm of x");
-  addFunction(Function_Log, "math.log", 1u, 1u, "Natural logarithm", "Returns nth logarithm of e");
-  addFunction(Function_Log2, "math.log2", 1u, 1u, "Binary logarithm", "Returns nth logarithm of 2");
-  addFunction(Function_Log10, "math.log10", 1u, 1u, "Decimal logarithm", "Returns nth logarithm of 10");
-  functionInfoMap.push_back(std::make_tuple(nullptr, "", ""));
-
-  addFunction(Function_Sin, "math.sin", 1u, 1u, "Sine", "Trigonometric function");
-  addFunction(Function_Cos, "math.cos", 1u, 1u, "Cosine", "Trigonometric function");
-  addFunction(Function_Tan, "math.tan", 1u, 1u, "tangent", "Trigonometric function");
-  addFunction(Function_Cot, "math.cot", 1u, 1u, "cotangent", "Trigonometric function");
-  addFunction(Function_Sec, "math.sec", 1u, 1u, "secant", "Trigonometric function");
-  addFunction(Function_Csc, "math.csc", 1u, 1u, "cosecant", "Trigonometric function");
-
-  addFunction(Function_ASin, "math.asin", 1u, 1u, "Arcsine", "Trigonometric function");
-  addFunction(Function_ACos, "math.acos", 1u, 1u, "Arccosine", "Trigonometric function");
-  addFunction(Function_ATan, "math.atan", 1u, 1u, "Arctangent", "Trigonometric function");
-  addFunction(Function_ATan2, "math.atan2", 2u, 2u, "Arctangent 2", "Trigonometric function (2 argument version)");
-  addFunction(Function_ACot, "math.acot", 1u, 1u, "Arccotangent", "Trigonometric function");
-  addFunction(Function_ASec, "math.asec", 1u, 1u, "Arcsecant", "Trigonometric function");
-  addFunction(Function_ACsc, "math.acsc", 1u, 1u, "Arccosecant", "Trigonometric function");
-
-  addFunction(Function_SinH, "math.sinh", 1u, 1u, "Hyperbolic sine", "Trigonometric function");
-  addFunction(Function_CosH, "math.cosh", 1u, 1u, "Hyperbolic cosine", "Trigonometric function");
-  addFunction(Function_TanH, "math.tanh", 1u, 1u, "Hyperbolic tangent", "Trigonometric function");
-  addFunction(Function_CotH, "math.coth", 1u, 1u, "Hyperbolic cotangent", "Trigonometric function");
-  addFunction(Function_SecH, "math.sech", 1u, 1u, "Hyperbolic secant", "Trigonometric function");
-  addFunction(Function_CscH, "math.csch", 1u, 1u, "Hyperbolic cosecant", "Trigonometric function");
-
-  addFunction(Function_ASinH, "math.asinh", 1u, 1u, "Hyperbolic arcsine", "Trigonometric function");
-  addFunction(Function_ACosH, "math.acosh", 1u, 1u, "Hyperbolic arccosine", "Trigonometric function");
-  addFunction(Function_ATanH, "math.atanh", 1u, 1u, "Hyperbolic arctangent", "Trigonometric function");
-  addFunction(Function_ACotH, "math.acoth", 1u, 1u, "Hyperbolic arccotangent", "Trigonometric function");
-  addFunction(Function_ASecH, "math.asech", 1u, 1u, "Hyperbolic arcsecant", "Trigonometric function");
-  addFunction(Function_ACscH, "math.acsch", 1u, 1u, "Hyperbolic arccosecant", "Trigonometric function");
-  functionInfoMap.push_back(std::make_tuple(nullptr, "", ""));
-
-  addFunction(Function_Min, "min", 1u, FunctionToken::GetArgumentCountMaxLimit(), "Min", "Returns the minimum of specified arguments");
-  addFunction(Function_Max, "max", 1u, FunctionToken::GetArgumentCountMaxLimit(), "Max", "Returns the maximum of specified arguments");
-
-  addFunction(Function_Mean, "math.mean", 1u, FunctionToken::GetArgumentCountMaxLimit(), "Mean", "Returns the mean of specified arguments");
-  addFunction(Function_Median, "math.median", 1u, FunctionToken::GetArgumentCountMaxLimit(), "Median", "Returns the median of specified arguments");
-  addFunction(Function_Mode, "math.mode", 1u, FunctionToken::GetArgumentCountMaxLimit(), "Mode", "Returns the mode of specified arguments");
-  addFunction(Function_Quartile_Lower,
-              "math.q1",
-              1u,
-              FunctionToken::GetArgumentCountMaxLimit(),
-              "First quartile",
-              "Returns the first quartile of specified arguments");
-  addFunction(Function_Median,
-              "math.q2",
-              1u,
-              FunctionToken::GetArgumentCountMaxLimit(),
-              "Second quartile",
-              "Returns the second quartile of specified arguments");
-  addFunction(Function_Quartile_Upper,
-              "math.q3",
-              1u,
-              FunctionToken::GetArgumentCountMaxLimit(),
-              "Third quartile",
-              "Returns the third quartile of specified arguments");
-  addFunction(Function_StdDev,
-              "math.stddev",
-              1u,
-              FunctionToken::GetArgumentCountMaxLimit(),
-              "Standard deviation",
-              "Returns the standard deviation of specified arguments");
-  functionInfoMap.push_back(std::make_tuple(nullptr, "", ""));
-
-  addFunction(Function_Str, "str", 1u, 1u, "Stringify", "Returns string representation of argument");
-  addFunction(Function_StrLen, "strlen", 1u, 1u, "String length", "Returns length of string argument");
-  functionInfoMap.push_back(std::make_tuple(nullptr, "", ""));
+  context.functionInfoMap.push_back(std::make_tuple(nullptr, "", ""));
+
+  addNumericFunctions<DefaultArithmeticType>();
+
+  addFunction(Function_Sum, "sum", 4u, 4u, "Summation", "Returns the sum of expression string x evaluated with variable y stepping from z through w");
+  addFunction(Function_Prod, "prod", 4u, 4u, "Product", "Returns the product of expression string x evaluated with variable y stepping from z through w");
+  context.functionInfoMap.push_back(std::make_tuple(nullptr, "", ""));
+
+  addStringFunctions<DefaultArithmeticType>();
 
   addFunction(Function_Date, "date", 0u, 1u, "Date", "Returns a date/time value that respresents the argument or the current date/time if empty");
   addFunction(Function_Dur, "dur", 1u, 1u, "Duration", "Returns a value representing a time duration specified by argument");
-  functionInfoMap.push_back(std::make_tuple(nullptr, "", ""));
+  context.functionInfoMap.push_back(std::make_tuple(nullptr, "", ""));
 
   addFunction(Function_Random, "random", 0, 2, "Random", "Returns a random number between (0 and 1), (0 and x) or (x and y) depending of arguments specified");
-  functionInfoMap.push_back(std::make_tuple(nullptr, "", ""));
+  context.functionInfoMap.push_back(std::make_tuple(nullptr, "", ""));
 
-  InitChemicalExpressionParser(chemicalExpressionParser);
+  InitChemicalExpressionParser(context.chemicalExpressionParser);
   addFunction(Function_MolarMass, "chem.M", 1u, 1u, "Molar mass", "Returns molar mass calculated from chemical compound string");
 
-  addVariable(nullptr, "null", "Null", "Represents an undefined value type");
-  addVariable(nullptr, "nil", "Nil", "Represents an undefined value type");
-  addVariable(nullptr, "none", "None", "Represents an undefined value type");
-  mpfr::mpreal tmpValue;
-  addVariable(tmpValue.setNan(), "nan", "Not a number", "Represents an undefined numeric value");
-  addVariable(mpfr::const_infinity(), "inf", "Infinity", "Represents infinity");
-  addVariable(1, "true", "True", "Boolean value");
-  addVariable(0, "false", "False", "Boolean value");
-  variableInfoMap.push_back(std::make_tuple(nullptr, "", ""));
-
-  addVariable(mpfr::const_pi(), "math.pi", "Pi", "Mathematical constant");
-  addVariable(mpfr::const_euler(), "math.E", "Euler-Mascheroni constant", "Mathematical constant");
-  addVariable(mpfr::const_catalan(), "math.catalan", "Catalan's constant", "Mathematical constant");
-  addVariable(mpfr::const_log2(), "math.ln2", "Logarithm of 2", "Mathematical constant");
-  addVariable(mpfr::mpreal("2.71828182846"), "math.e", "Euler's number", "Mathematical constant");
-  variableInfoMap.push_back(std::make_tuple(nullptr, "", ""));
-
-  addVariable(mpfr::exp10(mpfr::mpreal(30)), "Q", "Quetta", "Metric prefix (10^30)");
-  addVariable(mpfr::exp10(mpfr::mpreal(27)), "R", "Ronna", "Metric prefix (10^27)");
-  addVariable(mpfr::exp10(mpfr::mpreal(24)), "Y", "Yotta", "Metric prefix (10^24)");
-  addVariable(mpfr::exp10(mpfr::mpreal(21)), "Z", "Zetta", "Metric prefix (10^21)");
-  addVariable(mpfr::exp10(mpfr::mpreal(18)), "E", "Exa", "Metric prefix (10^18)");
-  addVariable(mpfr::exp10(mpfr::mpreal(15)), "P", "Peta", "Metric prefix (10^15)");
-  addVariable(mpfr::exp10(mpfr::mpreal(12)), "T", "Tera", "Metric prefix (10^12)");
-  addVariable(mpfr::exp10(mpfr::mpreal(9)), "G", "Giga", "Metric prefix (10^9)");
-  addVariable(mpfr::exp10(mpfr::mpreal(6)), "M", "Mega", "Metric prefix (10^6)");
-  addVariable(mpfr::exp10(mpfr::mpreal(3)), "k", "Kilo", "Metric prefix (10^3)");
-  addVariable(mpfr::exp10(mpfr::mpreal(2)), "h", "Hecto", "Metric prefix (10^2)");
-  addVariable(mpfr::exp10(mpfr::mpreal(1)), "da", "Deca", "Metric prefix (10^1)");
-  addVariable(mpfr::exp10(mpfr::mpreal(-1)), "d", "Deci", "Metric prefix (10^-1)");
-  addVariable(mpfr::exp10(mpfr::mpreal(-2)), "c", "Centi", "Metric prefix (10^-2)");
-  addVariable(mpfr::exp10(mpfr::mpreal(-3)), "m", "Milli", "Metric prefix (10^-3)");
-  addVariable(mpfr::exp10(mpfr::mpreal(-6)), "u", "Micro", "Metric prefix (10^-6)");
-  addVariable(mpfr::exp10(mpfr::mpreal(-9)), "n", "Nano", "Metric prefix (10^-9)");
-  addVariable(mpfr::exp10(mpfr::mpreal(-12)), "p", "Pico", "Metric prefix (10^-12)");
-  addVariable(mpfr::exp10(mpfr::mpreal(-15)), "f", "Femto", "Metric prefix (10^-15)");
-  addVariable(mpfr::exp10(mpfr::mpreal(-18)), "a", "Atto", "Metric prefix (10^-18)");
-  addVariable(mpfr::exp10(mpfr::mpreal(-21)), "z", "Zepto", "Metric prefix (10^-21)");
-  addVariable(mpfr::exp10(mpfr::mpreal(-24)), "y", "Yocto", "Metric prefix (10^-24)");
-  addVariable(mpfr::exp10(mpfr::mpreal(-27)), "r", "Ronto", "Metric prefix (10^-27)");
-  addVariable(mpfr::exp10(mpfr::mpreal(-30)), "q", "Quekto", "Metric prefix (10^-30)");
-  variableInfoMap.push_back(std::make_tuple(nullptr, "", ""));
-
-  addVariable(mpfr::exp2(mpfr::mpreal(10)), "Ki", "Kibi", "Binary prefix (2^10)");
-  addVariable(mpfr::exp2(mpfr::mpreal(20)), "Mi", "Mebi", "Binary prefix (2^20)");
-  addVariable(mpfr::exp2(mpfr::mpreal(30)), "Gi", "Gibi", "Binary prefix (2^30)");
-  addVariable(mpfr::exp2(mpfr::mpreal(40)), "Ti", "Tebi", "Binary prefix (2^40)");
-  addVariable(mpfr::exp2(mpfr::mpreal(50)), "Pi", "Pebi", "Binary prefix (2^50)");
-  addVariable(mpfr::exp2(mpfr::mpreal(60)), "Ei", "Exbi", "Binary prefix (2^60)");
-  addVariable(mpfr::exp2(mpfr::mpreal(60)), "Zi", "Zebi", "Binary prefix (2^70)");
-  addVariable(mpfr::exp2(mpfr::mpreal(60)), "Yi", "Yobi", "Binary prefix (2^80)");
-  variableInfoMap.push_back(std::make_tuple(nullptr, "", ""));
-
-  addVariable(mpfr::exp10(mpfr::mpreal(-2)), "pc", "Percent", "Parts-per notation (10^-2)");
-  addVariable(mpfr::exp10(mpfr::mpreal(-3)), "pm", "Permille", "Parts-per notation (10^-3)");
-  addVariable(mpfr::exp10(mpfr::mpreal(-4)), "ptt", "Parts per ten thousand", "Parts-per notation (10^-4)");
-  addVariable(mpfr::exp10(mpfr::mpreal(-6)), "ppm", "Parts per million", "Parts-per notation (10^-6)");
-  addVariable(mpfr::exp10(mpfr::mpreal(-9)), "ppb", "Parts per billion", "Parts-per notation (10^-9)");
-  addVariable(mpfr::exp10(mpfr::mpreal(-12)), "ppt", "Parts per trillion", "Parts-per notation (10^-12)");
-  addVariable(mpfr::exp10(mpfr::mpreal(-15)), "ppq", "Parts per quadrillion", "Parts-per notation (10^-15)");
-  variableInfoMap.push_back(std::make_tuple(nullptr, "", ""));
-
-  addVariable(boost::posix_time::hours(1l), "time.h", "Hour", "60 * 60 seconds");
-  addVariable(boost::posix_time::minutes(1l), "time.m", "Minute", "60 seconds");
-  addVariable(boost::posix_time::seconds(1l), "time.s", "Second", "1 second");
-  addVariable(boost::posix_time::milliseconds(1l), "time.ms", "Millisecond", "10^-3 of a second");
-  addVariable(boost::posix_time::microseconds(1l), "time.us", "Microsecond", "10^-6 of a second");
-  addVariable(boost::posix_time::nanoseconds(1l), "time.ns", "Nanosecond", "10^-9 of a second");
-  addVariable(boost::posix_time::hours(24l), "time.d", "Day", "24 hours");
-  variableInfoMap.push_back(std::make_tuple(nullptr, "", ""));
-
-  addVariable(mpfr::mpreal(CHAR_BIT), "bpB", "Bits per byte", "Common value for number of bits per byte");
-
-  addVariable(mpfr::mpreal("-1000", mpfr::mpreal::get_default_prec(), 2), "i4.min", "Signed nibble min", "4 bit signed integer min. limit");
-  addVariable(mpfr::mpreal("0111", mpfr::mpreal::get_default_prec(), 2), "i4.max", "Signed nibble max", "4 bit signed integer max. limit");
-  addVariable(mpfr::mpreal(std::numeric_limits<std::int8_t>::min()), "i8.min", "Signed byte min", "8 bit signed integer min. limit");
-  addVariable(mpfr::mpreal(std::numeric_limits<std::int8_t>::max()), "i8.max", "Signed byte max", "8 bit signed integer max. limit");
-  addVariable(mpfr::mpreal(std::numeric_limits<std::int16_t>::min()), "i16.min", "Signed short min", "16 bit signed integer min. limit");
-  addVariable(mpfr::mpreal(std::numeric_limits<std::int16_t>::max()), "i16.max", "Signed short max", "16 bit signed integer max. limit");
-  addVariable(mpfr::mpreal("-100000000000000000000000", mpfr::mpreal::get_default_prec(), 2),
-              "i24.min",
-              "Signed 24-bit min",
-              "24 bit signed integer min. limit");
-  addVariable(mpfr::mpreal("011111111111111111111111", mpfr::mpreal::get_default_prec(), 2),
-              "i24.max",
-              "Signed 24-bit max",
-              "24 bit signed integer max. limit");
-  addVariable(mpfr::mpreal(std::numeric_limits<std::int32_t>::min()), "i32.min", "Signed int min", "32 bit signed integer min. limit");
-  addVariable(mpfr::mpreal(std::numeric_limits<std::int32_t>::max()), "i32.max", "Signed int max", "32 bit signed integer max. limit");
-  addVariable(mpfr::mpreal(std::numeric_limits<std::int64_t>::min()), "i64.min", "Signed long min", "64 bit signed integer min. limit");
-  addVariable(mpfr::mpreal(std::numeric_limits<std::int64_t>::max()), "i64.max", "Signed long max", "64 bit signed integer max. limit");
-  addVariable(mpfr::mpreal("-10000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000",
-                           mpfr::mpreal::get_default_prec(),
-                           2),
-              "i128.min",
-              "Signed long long min",
-              "128 bit signed integer min. limit");
-  addVariable(mpfr::mpreal("01111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111",
-                           mpfr::mpreal::get_default_prec(),
-                           2),
-              "i128.max",
-              "Signed long long max",
-              "128 bit signed integer max. limit");
-
-  addVariable(mpfr::mpreal("0000", mpfr::mpreal::get_default_prec(), 2), "u4.min", "Unsigned nibble min", "4 bit unsigned integer min. limit");
-  addVariable(mpfr::mpreal("1111", mpfr::mpreal::get_default_prec(), 2), "u4.max", "Unsigned nibble max", "4 bit unsigned integer max. limit");
-  addVariable(mpfr::mpreal(std::numeric_limits<std::uint8_t>::min()), "u8.min", "Unsigned byte min", "8 bit unsigned integer min. limit");
-  addVariable(mpfr::mpreal(std::numeric_limits<std::uint8_t>::max()), "u8.max", "Unsigned byte max", "8 bit unsigned integer max. limit");
-  addVariable(mpfr::mpreal(std::numeric_limits<std::uint16_t>::min()), "u16.min", "Unsigned short min", "16 bit unsigned integer min. limit");
-  addVariable(mpfr::mpreal(std::numeric_limits<std::uint16_t>::max()), "u16.max", "Unsigned short max", "16 bit unsigned integer max. limit");
-  addVariable(mpfr::mpreal("000000000000000000000000", mpfr::mpreal::get_default_prec(), 2),
-              "u24.min",
-              "Unsigned 24-bit min",
-              "24 bit unsigned integer min. limit");
-  addVariable(mpfr::mpreal("111111111111111111111111", mpfr::mpreal::get_default_prec(), 2),
-              "u24.max",
-              "Unsigned 24-bit max",
-              "24 bit unsigned integer max. limit");
-  addVariable(mpfr::mpreal(std::numeric_limits<std::uint32_t>::min()), "u32.min", "Unsigned int min", "32 bit unsigned integer min. limit");
-  addVariable(mpfr::mpreal(std::numeric_limits<std::uint32_t>::max()), "u32.max", "Unsigned int max", "32 bit unsigned integer max. limit");
-  addVariable(mpfr::mpreal(std::numeric_limits<std::uint64_t>::min()), "u64.min", "Unsigned long min", "64 bit unsigned integer min. limit");
-  addVariable(mpfr::mpreal(std::numeric_limits<std::uint64_t>::max()), "u64.max", "Unsigned long max", "64 bit unsigned integer max. limit");
-  addVariable(mpfr::mpreal("00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000",
-                           mpfr::mpreal::get_default_prec(),
-                           2),
-              "u128.min",
-              "Unsigned long long min",
-              "128 bit unsigned integer min. limit");
-  addVariable(mpfr::mpreal("11111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111",
-                           mpfr::mpreal::get_default_prec(),
-                           2),
-              "u128.max",
-              "Unsigned long long max",
-              "128 bit unsigned integer max. limit");
-
-  addVariable(mpfr::mpreal(std::numeric_limits<float>::min()), "f32.min", "Float min", "32 bit floating point min. limit");
-  addVariable(mpfr::mpreal(std::numeric_limits<float>::max()), "f32.max", "Float max", "32 bit floating point max. limit");
-  addVariable(mpfr::mpreal(std::numeric_limits<float>::epsilon()), "f32.epsilon", "Float epsilon", "32 bit floating point epsilon");
-  addVariable(mpfr::mpreal(std::numeric_limits<double>::min()), "f64.min", "Double min", "64 bit floating point min. limit");
-  addVariable(mpfr::mpreal(std::numeric_limits<double>::max()), "f64.max", "Double max", "64 bit floating point max. limit");
-  addVariable(mpfr::mpreal(std::numeric_limits<double>::epsilon()), "f64.epsilon", "Double epsilon", "64 bit floating point epsilon");
+  addVariable<DefaultVariableType>(nullptr, "null", "Null", "Represents an undefined value type");
+  addVariable<DefaultVariableType>(nullptr, "nil", "Nil", "Represents an undefined value type");
+  addVariable<DefaultVariableType>(nullptr, "none", "None", "Represents an undefined value type");
+  addLazyVariable([]() { return mpfr::mpreal().setNan(); }, "nan", "Not a number", "Represents an undefined numeric value");
+  addLazyVariable([]() { return mpfr::const_infinity(); }, "inf", "Infinity", "Represents infinity");
+  addVariable<DefaultVariableType>(1, "true", "True", "Boolean value");
+  addVariable<DefaultVariableType>(0, "false", "False", "Boolean value");
+  context.variableInfoMap.push_back(std::make_tuple("", "", ""));
+
+  addLazyVariable([]() { return mpfr::const_pi(); }, "math.pi", "Pi", "Mathematical constant");
+  addLazyVariable([]() { return mpfr::const_euler(); }, "math.E", "Euler-Mascheroni constant", "Mathematical constant");
+  addLazyVariable([]() { return mpfr::const_catalan(); }, "math.catalan", "Catalan's constant", "Mathematical constant");
+  addLazyVariable([]() { return mpfr::const_log2(); }, "math.ln2", "Logarithm of 2", "Mathematical constant");
+  addLazyVariable([]() { return mpfr::mpreal("2.71828182846"); }, "math.e", "Euler's number", "Mathematical constant");
+  context.variableInfoMap.push_back(std::make_tuple("", "", ""));
+
+  addNumericPrefixes<DefaultArithmeticType>();
+
+  addVariable<DefaultVariableType>(boost::posix_time::hours(1l), "time.h", "Hour", "60 * 60 seconds");
+  addVariable<DefaultVariableType>(boost::posix_time::minutes(1l), "time.m", "Minute", "60 seconds");
+  addVariable<DefaultVariableType>(boost::posix_time::seconds(1l), "time.s", "Second", "1 second");
+  addVariable<DefaultVariableType>(boost::posix_time::milliseconds(1l), "time.ms", "Millisecond", "10^-3 of a second");
+  addVariable<DefaultVariableType>(boost::posix_time::microseconds(1l), "time.us", "Microsecond", "10^-6 of a second");
+  addVariable<DefaultVariableType>(boost::posix_time::nanoseconds(1l), "time.ns", "Nanosecond", "10^-9 of a second");
+  addVariable<DefaultVariableType>(boost::posix_time::hours(24l), "time.d", "Day", "24 hours");
+  context.variableInfoMap.push_back(std::make_tuple("", "", ""));
+
+  addVariable<DefaultVariableType>(mpfr::mpreal(CHAR_BIT), "bpB", "Bits per byte", "Common value for number of bits per byte");
+
+  addLazyVariable(integerMin<4, true>, "i4.min", "Signed nibble min", "4 bit signed integer min. limit");
+  addLazyVariable(integerMax<4, true>, "i4.max", "Signed nibble max", "4 bit signed integer max. limit");
+  addLazyVariable(integerMin<8, true>, "i8.min", "Signed byte min", "8 bit signed integer min. limit");
+  addLazyVariable(integerMax<8, true>, "i8.max", "Signed byte max", "8 bit signed integer max. limit");
+  addLazyVariable(integerMin<16, true>, "i16.min", "Signed short min", "16 bit signed integer min. limit");
+  addLazyVariable(integerMax<16, true>, "i16.max", "Signed short max", "16 bit signed integer max. limit");
+  addLazyVariable(integerMin<24, true>, "i24.min", "Signed 24-bit min", "24 bit signed integer min. limit");
+  addLazyVariable(integerMax<24, true>, "i24.max", "Signed 24-bit max", "24 bit signed integer max. limit");
+  addLazyVariable(integerMin<32, true>, "i32.min", "Signed int min", "32 bit signed integer min. limit");
+  addLazyVariable(integerMax<32, true>, "i32.max", "Signed int max", "32 bit signed integer max. limit");
+  addLazyVariable(integerMin<64, true>, "i64.min", "Signed long min", "64 bit signed integer min. limit");
+  addLazyVariable(integerMax<64, true>, "i64.max", "Signed long max", "64 bit signed integer max. limit");
+  addLazyVariable(integerMin<128, true>, "i128.min", "Signed long long min", "128 bit signed integer min. limit");
+  addLazyVariable(integerMax<128, true>, "i128.max", "Signed long long max", "128 bit signed integer max. limit");
+
+  addLazyVariable(integerMin<4, false>, "u4.min", "Unsigned nibble min", "4 bit unsigned integer min. limit");
+  addLazyVariable(integerMax<4, false>, "u4.max", "Unsigned nibble max", "4 bit unsigned integer max. limit");
+  addLazyVariable(integerMin<8, false>, "u8.min", "Unsigned byte min", "8 bit unsigned integer min. limit");
+  addLazyVariable(integerMax<8, false>, "u8.max", "Unsigned byte max", "8 bit unsigned integer max. limit");
+  addLazyVariable(integerMin<16, false>, "u16.min", "Unsigned short min", "16 bit unsigned integer min. limit");
+  addLazyVariable(integerMax<16, false>, "u16.max", "Unsigned short max", "16 bit unsigned integer max. limit");
+  addLazyVariable(integerMin<24, false>, "u24.min", "Unsigned 24-bit min", "24 bit unsigned integer min. limit");
+  addLazyVariable(integerMax<24, false>, "u24.max", "Unsigned 24-bit max", "24 bit unsigned integer max. limit");
+  addLazyVariable(integerMin<32, false>, "u32.min", "Unsigned int min", "32 bit unsigned integer min. limit");
+  addLazyVariable(integerMax<32, false>, "u32.max", "Unsigned int max", "32 bit unsigned integer max. limit");
+  addLazyVariable(integerMin<64, false>, "u64.min", "Unsigned long min", "64 bit unsigned integer min. limit");
+  addLazyVariable(integerMax<64, false>, "u64.max", "Unsigned long max", "64 bit unsigned integer max. limit");
+  addLazyVariable(integerMin<128, false>, "u128.min", "Unsigned long long min", "128 bit unsigned integer min. limit");
+  addLazyVariable(integerMax<128, false>, "u128.max", "Unsigned long long max", "128 bit unsigned integer max. limit");
+
+  addLazyVariable([]() { return mpfr::mpreal(std::numeric_limits<float>::min()); }, "f32.min", "Float min", "32 bit floating point min. limit");
+  addLazyVariable([]() { return mpfr::mpreal(std::numeric_limits<float>::max()); }, "f32.max", "Float max", "32 bit floating point max. limit");
+  addLazyVariable([]() { return mpfr::mpreal(std::numeric_limits<float>::epsilon()); }, "f32.epsilon", "Float epsilon", "32 bit floating point epsilon");
+  addLazyVariable([]() { return mpfr::mpreal(std::numeric_limits<double>::min()); }, "f64.min", "Double min", "64 bit floating point min. limit");
+  addLazyVariable([]() { return mpfr::mpreal(std::numeric_limits<double>::max()); }, "f64.max", "Double max", "64 bit floating point max. limit");
+  addLazyVariable([]() { return mpfr::mpreal(std::numeric_limits<double>::epsilon()); }, "f64.epsilon", "Double epsilon", "64 bit floating point epsilon");
+
+  context.IndexSymbols();
 }
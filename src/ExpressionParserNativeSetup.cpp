@@ -0,0 +1,734 @@
+#include "Aggregates.hpp"
+#include "Combinatorics.hpp"
+#include "DecimalFormatter.hpp"
+#include "KalkContext.hpp"
+#include "NumericSetup.hpp"
+#include "Setup.hpp"
+#include "Trace.hpp"
+#include "ValueArena.hpp"
+#include "VectorKernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <utility>
+
+#include <boost/format.hpp>
+
+// Native values always live on the heap. They are counted as heap allocations like those made by makeValue(), so allocation statistics cover both engines.
+template<class... TArgs>
+static NativeValueType* makeNativeValue(TArgs&&... args)
+{
+  allocationCounters.heapAllocations++;
+  return new NativeValueType(std::forward<TArgs>(args)...);
+}
+
+// Base 10 literals go through strtod, which rounds correctly. Literals in other bases are accumulated digit by digit, which is exact until the
+// mantissa runs out of bits.
+static IValueToken* numberConverter(const std::string& value)
+{
+  const auto& context = currentContext();
+  if(context.options.input_base == 10)
+  {
+    char* end         = nullptr;
+    const auto result = std::strtod(value.c_str(), &end);
+    if(value.empty() || end != value.c_str() + value.size())
+    {
+      throw SyntaxError((boost::format("Invalid number: %1%") % value).str());
+    }
+
+    return makeNativeValue(static_cast<NativeArithmeticType>(result));
+  }
+
+  const auto base               = static_cast<NativeArithmeticType>(context.options.input_base);
+  NativeArithmeticType integer  = 0;
+  NativeArithmeticType fraction = 0;
+  NativeArithmeticType scale    = 1;
+  bool hasPoint                 = false;
+  bool hasDigit                 = false;
+  for(const char i : value)
+  {
+    if(i == '.' && !hasPoint)
+    {
+      hasPoint = true;
+      continue;
+    }
+
+    const int digit = digitValue(i);
+    if(digit < 0 || digit >= context.options.input_base)
+    {
+      throw SyntaxError((boost::format("Invalid number in base %1%: %2%") % context.options.input_base % value).str());
+    }
+
+    if(hasPoint)
+    {
+      scale /= base;
+      fraction += digit * scale;
+    }
+    else
+    {
+      integer = (integer * base) + digit;
+    }
+
+    hasDigit = true;
+  }
+
+  if(!hasDigit)
+  {
+    throw SyntaxError((boost::format("Invalid number in base %1%: %2%") % context.options.input_base % value).str());
+  }
+
+  return makeNativeValue(integer + fraction);
+}
+
+static IValueToken* stringConverter(const std::string& value) { return makeNativeValue(value); }
+
+static NativeArithmeticType toNative(const IValueToken* value) { return value->As<const NativeValueType*>()->GetValue<NativeArithmeticType>(); }
+
+// Value truncated to an integer, for bitwise operations.
+static long long toNativeInteger(const IValueToken* value)
+{
+  const auto tmpValue = std::trunc(toNative(value));
+  if(!std::isfinite(tmpValue))
+  {
+    throw std::domain_error("Integer operation on non-finite value");
+  }
+
+  // Powers of two are exact in doubles, so the range check is exact too.
+  const auto limit = std::ldexp(NativeArithmeticType(1), std::numeric_limits<long long>::digits);
+  if(tmpValue < -limit || tmpValue >= limit)
+  {
+    throw std::domain_error("Integer operation out of range");
+  }
+
+  return static_cast<long long>(tmpValue);
+}
+
+// Shift count for ldexp(). The range is symmetric, so negating the count for a right shift cannot overflow.
+static int toNativeShift(const IValueToken* value)
+{
+  const auto tmpValue = toNativeInteger(value);
+  if(tmpValue < -std::numeric_limits<int>::max() || tmpValue > std::numeric_limits<int>::max())
+  {
+    throw std::range_error("Value out of range");
+  }
+
+  return static_cast<int>(tmpValue);
+}
+
+static bool isVector(const IValueToken* value) { return value->GetType() == typeid(NativeVectorType); }
+
+static const NativeVectorType& toVector(const IValueToken* value) { return value->As<const NativeValueType*>()->GetValue<NativeVectorType>(); }
+
+// Argument values with vector arguments expanded in place.
+static std::vector<NativeArithmeticType> toNativeVector(const std::vector<IValueToken*>& args)
+{
+  std::vector<NativeArithmeticType> result;
+  result.reserve(args.size());
+  for(const auto& i : args)
+  {
+    if(isVector(i))
+    {
+      const auto& elements = toVector(i).GetElements();
+      result.insert(result.end(), elements.cbegin(), elements.cend());
+    }
+    else
+    {
+      result.push_back(toNative(i));
+    }
+  }
+
+  if(result.empty())
+  {
+    throw std::domain_error("Aggregate of an empty vector");
+  }
+
+  return result;
+}
+
+// Like toNativeVector(), but a lone vector argument is used as is rather than copied into buffer.
+static const std::vector<NativeArithmeticType>& toNativeVector(const std::vector<IValueToken*>& args, std::vector<NativeArithmeticType>& buffer)
+{
+  if(args.size() == 1u && isVector(args.front()) && !toVector(args.front()).IsEmpty())
+  {
+    return toVector(args.front()).GetElements();
+  }
+
+  buffer = toNativeVector(args);
+  return buffer;
+}
+
+// Operand of an elementwise operation: the elements of a vector, or a number repeated through a zero stride.
+struct ElementwiseOperand
+{
+  explicit ElementwiseOperand(const IValueToken* value)
+      : scalar(isVector(value) ? NativeArithmeticType(0) : toNative(value))
+      , data(isVector(value) ? toVector(value).GetData() : &scalar)
+      , stride(isVector(value) ? 1u : 0u)
+      , size(isVector(value) ? toVector(value).GetSize() : 1u)
+  {}
+
+  ElementwiseOperand(const ElementwiseOperand&)            = delete;
+  ElementwiseOperand& operator=(const ElementwiseOperand&) = delete;
+
+  NativeArithmeticType scalar;
+  const NativeArithmeticType* data;
+  std::size_t stride;
+  std::size_t size;
+};
+
+static std::size_t elementwiseSize(const ElementwiseOperand& lhs, const ElementwiseOperand& rhs)
+{
+  if(lhs.stride != 0u && rhs.stride != 0u && lhs.size != rhs.size)
+  {
+    throw SyntaxError((boost::format("Vector length mismatch: %1%, %2%") % lhs.size % rhs.size).str());
+  }
+
+  return lhs.stride != 0u ? lhs.size : rhs.size;
+}
+
+static IValueToken* elementwise(VectorOperation operation, const IValueToken* lhs, const IValueToken* rhs)
+{
+  const ElementwiseOperand lhsOperand(lhs);
+  const ElementwiseOperand rhsOperand(rhs);
+  NativeVectorType result(elementwiseSize(lhsOperand, rhsOperand));
+  applyVectorOperation(operation, lhsOperand.data, lhsOperand.stride, rhsOperand.data, rhsOperand.stride, result.GetData(), result.GetSize());
+  return makeNativeValue(std::move(result));
+}
+
+static IValueToken* elementwise(VectorFunction function, const IValueToken* value)
+{
+  const auto& values = toVector(value);
+  NativeVectorType result(values.GetSize());
+  applyVectorFunction(function, values.GetData(), result.GetData(), result.GetSize());
+  return makeNativeValue(std::move(result));
+}
+
+// Applies function to a number, or to every element of a vector.
+template<class TFunction>
+static IValueToken* broadcast(const IValueToken* value, const TFunction& function)
+{
+  if(!isVector(value))
+  {
+    return makeNativeValue(function(toNative(value)));
+  }
+
+  const auto& values = toVector(value);
+  NativeVectorType result(values.GetSize());
+  std::transform(values.GetElements().cbegin(), values.GetElements().cend(), result.GetElements().begin(), function);
+  return makeNativeValue(std::move(result));
+}
+
+template<class TFunction>
+static IValueToken* broadcast(const IValueToken* lhs, const IValueToken* rhs, const TFunction& function)
+{
+  if(!isVector(lhs) && !isVector(rhs))
+  {
+    return makeNativeValue(function(toNative(lhs), toNative(rhs)));
+  }
+
+  const ElementwiseOperand lhsOperand(lhs);
+  const ElementwiseOperand rhsOperand(rhs);
+  NativeVectorType result(elementwiseSize(lhsOperand, rhsOperand));
+  for(std::size_t i = 0u; i < result.GetSize(); i++)
+  {
+    result[i] = function(lhsOperand.data[i * lhsOperand.stride], rhsOperand.data[i * rhsOperand.stride]);
+  }
+
+  return makeNativeValue(std::move(result));
+}
+
+static int compareNative(const IValueToken* a, const IValueToken* b)
+{
+  if(a->GetType() == typeid(std::string) && b->GetType() == typeid(std::string))
+  {
+    return a->As<const NativeValueType*>()->GetValue<std::string>().compare(b->As<const NativeValueType*>()->GetValue<std::string>());
+  }
+  else if(a->GetType() == typeid(std::nullptr_t) && b->GetType() == typeid(std::nullptr_t))
+  {
+    return 0;
+  }
+
+  const auto aValue = toNative(a);
+  const auto bValue = toNative(b);
+  return aValue < bValue ? -1 : (aValue > bValue ? 1 : 0);
+}
+
+void printValue(const NativeValueType& value)
+{
+  const TraceSpan span("output", "printValue");
+  const auto& context = currentContext();
+  if(context.options.vnames && value.IsType<NativeVariableType>())
+  {
+    std::cout << value.As<const NativeVariableType&>().GetIdentifier();
+  }
+  else if(value.GetType() == typeid(NativeArithmeticType))
+  {
+    static thread_local DecimalFormatter formatter;
+    const int digits = std::min(context.options.digits, std::numeric_limits<NativeArithmeticType>::digits10);
+    std::string_view tmpString;
+    {
+      const TraceSpan formatSpan("output", "format");
+      tmpString = formatter.Format(value.GetValue<NativeArithmeticType>(), digits);
+    }
+
+    const TraceSpan writeSpan("output", "write");
+    std::cout.write(tmpString.data(), static_cast<std::streamsize>(tmpString.size()));
+  }
+  else if(value.GetType() == typeid(NativeVectorType))
+  {
+    static thread_local DecimalFormatter formatter;
+    const int digits     = std::min(context.options.digits, std::numeric_limits<NativeArithmeticType>::digits10);
+    const auto& elements = value.GetValue<NativeVectorType>();
+    std::cout << '[';
+    for(std::size_t i = 0u; i < elements.GetSize(); i++)
+    {
+      const auto tmpString = formatter.Format(elements[i], digits);
+      std::cout << (i > 0u ? ", " : "");
+      std::cout.write(tmpString.data(), static_cast<std::streamsize>(tmpString.size()));
+    }
+
+    std::cout << ']';
+  }
+  else
+  {
+    std::cout << value.ToString();
+  }
+
+  const TraceSpan writeSpan("output", "write");
+  std::cout << std::endl;
+}
+
+DefaultValueType toDefaultValue(const NativeValueType& value)
+{
+  if(value.GetType() == typeid(NativeArithmeticType))
+  {
+    return DefaultValueType(DefaultArithmeticType(value.GetValue<NativeArithmeticType>()));
+  }
+  else if(value.GetType() == typeid(std::string))
+  {
+    return DefaultValueType(value.GetValue<std::string>());
+  }
+  else if(value.GetType() == typeid(NativeVectorType))
+  {
+    const auto& elements = value.GetValue<NativeVectorType>().GetElements();
+    return DefaultValueType(DefaultVectorType(std::vector<DefaultArithmeticType>(elements.cbegin(), elements.cend())));
+  }
+
+  return DefaultValueType(nullptr);
+}
+
+#ifndef __REGION__UNOPS
+static IValueToken* UnaryOperator_Plus(IValueToken* rhs)
+{
+  return isVector(rhs) ? elementwise(VectorFunction::Abs, rhs) : makeNativeValue(std::fabs(toNative(rhs)));
+}
+
+static IValueToken* UnaryOperator_Minus(IValueToken* rhs)
+{
+  return isVector(rhs) ? elementwise(VectorFunction::Negate, rhs) : makeNativeValue(-toNative(rhs));
+}
+
+static IValueToken* UnaryOperator_Factorial(IValueToken* rhs)
+{
+  if(toNative(rhs) < 0)
+  {
+    throw std::range_error("Value cannot be negative");
+  }
+
+  return makeNativeValue(std::tgamma(std::trunc(toNative(rhs)) + 1));
+}
+
+static IValueToken* UnaryOperator_Not(IValueToken* rhs) { return makeNativeValue(static_cast<NativeArithmeticType>(toNative(rhs) == 0)); }
+
+static IValueToken* UnaryOperator_BitwiseOnesComplement(IValueToken* rhs)
+{
+  return makeNativeValue(static_cast<NativeArithmeticType>(~toNativeInteger(rhs)));
+}
+#endif // __REGION__UNOPS
+
+#ifndef __REGION__BINOPS
+#ifndef __REGION__BINOPS__COMPARISON
+static IValueToken* BinaryOperator_Equals(IValueToken* lhs, IValueToken* rhs)
+{
+  return makeNativeValue(static_cast<NativeArithmeticType>(compareNative(lhs, rhs) == 0));
+}
+
+static IValueToken* BinaryOperator_NotEquals(IValueToken* lhs, IValueToken* rhs)
+{
+  return makeNativeValue(static_cast<NativeArithmeticType>(compareNative(lhs, rhs) != 0));
+}
+
+static IValueToken* BinaryOperator_Lesser(IValueToken* lhs, IValueToken* rhs)
+{
+  return makeNativeValue(static_cast<NativeArithmeticType>(compareNative(lhs, rhs) < 0));
+}
+
+static IValueToken* BinaryOperator_Greater(IValueToken* lhs, IValueToken* rhs)
+{
+  return makeNativeValue(static_cast<NativeArithmeticType>(compareNative(lhs, rhs) > 0));
+}
+
+static IValueToken* BinaryOperator_LesserOrEquals(IValueToken* lhs, IValueToken* rhs)
+{
+  return makeNativeValue(static_cast<NativeArithmeticType>(compareNative(lhs, rhs) <= 0));
+}
+
+static IValueToken* BinaryOperator_GreaterOrEquals(IValueToken* lhs, IValueToken* rhs)
+{
+  return makeNativeValue(static_cast<NativeArithmeticType>(compareNative(lhs, rhs) >= 0));
+}
+
+static IValueToken* BinaryOperator_LogicalOr(IValueToken* lhs, IValueToken* rhs)
+{
+  return makeNativeValue(static_cast<NativeArithmeticType>(toNative(lhs) != 0 || toNative(rhs) != 0));
+}
+
+static IValueToken* BinaryOperator_LogicalAnd(IValueToken* lhs, IValueToken* rhs)
+{
+  return makeNativeValue(static_cast<NativeArithmeticType>(toNative(lhs) != 0 && toNative(rhs) != 0));
+}
+#endif // __REGION__BINOPS__COMPARISON
+
+#ifndef __REGION__BINOPS__COMMON
+static IValueToken* BinaryOperator_Addition(IValueToken* lhs, IValueToken* rhs)
+{
+  if(lhs->GetType() == typeid(std::string) || rhs->GetType() == typeid(std::string))
+  {
+    std::string tmpString;
+    if(lhs->GetType() != typeid(std::nullptr_t))
+    {
+      tmpString += lhs->ToString();
+    }
+
+    if(rhs->GetType() != typeid(std::nullptr_t))
+    {
+      tmpString += rhs->ToString();
+    }
+
+    return makeNativeValue(tmpString);
+  }
+  else if(isVector(lhs) || isVector(rhs))
+  {
+    return elementwise(VectorOperation::Addition, lhs, rhs);
+  }
+
+  return makeNativeValue(toNative(lhs) + toNative(rhs));
+}
+
+static IValueToken* BinaryOperator_Subtraction(IValueToken* lhs, IValueToken* rhs)
+{
+  if(isVector(lhs) || isVector(rhs))
+  {
+    return elementwise(VectorOperation::Subtraction, lhs, rhs);
+  }
+
+  return makeNativeValue(toNative(lhs) - toNative(rhs));
+}
+
+static IValueToken* BinaryOperator_Multiplication(IValueToken* lhs, IValueToken* rhs)
+{
+  if(isVector(lhs) || isVector(rhs))
+  {
+    return elementwise(VectorOperation::Multiplication, lhs, rhs);
+  }
+
+  return makeNativeValue(toNative(lhs) * toNative(rhs));
+}
+
+static IValueToken* BinaryOperator_Division(IValueToken* lhs, IValueToken* rhs)
+{
+  if(isVector(lhs) || isVector(rhs))
+  {
+    return elementwise(VectorOperation::Division, lhs, rhs);
+  }
+
+  return makeNativeValue(toNative(lhs) / toNative(rhs));
+}
+
+static IValueToken* BinaryOperator_TruncatedDivision(IValueToken* lhs, IValueToken* rhs)
+{
+  return broadcast(lhs, rhs, [](NativeArithmeticType x, NativeArithmeticType y) { return std::trunc(x / y); });
+}
+
+static IValueToken* BinaryOperator_Fmod(IValueToken* lhs, IValueToken* rhs)
+{
+  return broadcast(lhs, rhs, [](NativeArithmeticType x, NativeArithmeticType y) { return std::fmod(x, y); });
+}
+
+static IValueToken* BinaryOperator_Remainder(IValueToken* lhs, IValueToken* rhs)
+{
+  return broadcast(lhs, rhs, [](NativeArithmeticType x, NativeArithmeticType y) { return std::remainder(x, y); });
+}
+
+static IValueToken* BinaryOperator_Exponentiation(IValueToken* lhs, IValueToken* rhs)
+{
+  return broadcast(lhs, rhs, [](NativeArithmeticType x, NativeArithmeticType y) { return std::pow(x, y); });
+}
+#endif // __REGION__BINOPS__COMMON
+
+#ifndef __REGION__BINOPS__BITWISE
+static IValueToken* BinaryOperator_BitwiseOr(IValueToken* lhs, IValueToken* rhs)
+{
+  return makeNativeValue(static_cast<NativeArithmeticType>(toNativeInteger(lhs) | toNativeInteger(rhs)));
+}
+
+static IValueToken* BinaryOperator_BitwiseAnd(IValueToken* lhs, IValueToken* rhs)
+{
+  return makeNativeValue(static_cast<NativeArithmeticType>(toNativeInteger(lhs) & toNativeInteger(rhs)));
+}
+
+static IValueToken* BinaryOperator_BitwiseXor(IValueToken* lhs, IValueToken* rhs)
+{
+  return makeNativeValue(static_cast<NativeArithmeticType>(toNativeInteger(lhs) ^ toNativeInteger(rhs)));
+}
+
+static IValueToken* BinaryOperator_BitwiseLeftShift(IValueToken* lhs, IValueToken* rhs)
+{
+  return makeNativeValue(std::ldexp(std::trunc(toNative(lhs)), toNativeShift(rhs)));
+}
+
+static IValueToken* BinaryOperator_BitwiseRightShift(IValueToken* lhs, IValueToken* rhs)
+{
+  return makeNativeValue(std::floor(std::ldexp(std::trunc(toNative(lhs)), -toNativeShift(rhs))));
+}
+#endif // __REGION__BINOPS__BITWISE
+
+#ifndef __REGION__BINOPS__SPECIAL
+static IValueToken* BinaryOperator_VariableAssignment(IValueToken* lhs, IValueToken* rhs)
+{
+  auto& context                = currentContext();
+  NativeVariableType* variable = lhs->As<NativeVariableType*>();
+  if(variable == nullptr)
+  {
+    throw SyntaxError((boost::format("Assignment of non-variable type: %1% (%2%)") % lhs->ToString() % lhs->GetTypeInfo().name()).str());
+  }
+
+  bool isInitialAssignment = !variable->IsInitialized();
+
+  auto rhsValue = rhs->As<NativeValueType*>();
+  if(rhs->GetType() == typeid(NativeArithmeticType))
+  {
+    (*variable) = rhsValue->GetValue<NativeArithmeticType>();
+  }
+  else if(rhs->GetType() == typeid(std::string))
+  {
+    (*variable) = rhsValue->GetValue<std::string>();
+  }
+  else if(rhs->GetType() == typeid(std::nullptr_t))
+  {
+    (*variable) = rhsValue->GetValue<std::nullptr_t>();
+  }
+  else if(rhs->GetType() == typeid(NativeVectorType))
+  {
+    (*variable) = rhsValue->GetValue<NativeVectorType>();
+  }
+  else
+  {
+    throw SyntaxError((boost::format("Assignment from unsupported type: %1% (%2%)") % rhs->ToString() % rhs->GetType().name()).str());
+  }
+
+  if(isInitialAssignment)
+  {
+    auto variableIterator = context.defaultUninitializedVariableCache.extract(variable->GetIdentifier());
+    context.defaultInitializedVariableCache.insert(std::move(variableIterator));
+  }
+
+  return variable;
+}
+#endif // __REGION__BINOPS__SPECIAL
+#endif // __REGION__BINOPS
+
+#ifndef __REGION__FUNCTIONS
+static IValueToken* Function_Abs(const std::vector<IValueToken*>& args)
+{
+  return isVector(args[0]) ? elementwise(VectorFunction::Abs, args[0]) : makeNativeValue(std::fabs(toNative(args[0])));
+}
+
+static IValueToken* Function_Neg(const std::vector<IValueToken*>& args)
+{
+  return isVector(args[0]) ? elementwise(VectorFunction::Negate, args[0]) : makeNativeValue(-toNative(args[0]));
+}
+
+static IValueToken* Function_Sqrt(const std::vector<IValueToken*>& args)
+{
+  return isVector(args[0]) ? elementwise(VectorFunction::Sqrt, args[0]) : makeNativeValue(std::sqrt(toNative(args[0])));
+}
+#endif // __REGION__FUNCTIONS
+
+template<>
+struct NumericTraits<NativeArithmeticType>
+{
+  using ValueType  = NativeValueType;
+  using VectorType = NativeVectorType;
+  using ModeHash   = std::hash<NativeArithmeticType>;
+
+  template<class TValue>
+  static IValueToken* MakeValue(TValue&& value)
+  {
+    return makeNativeValue(std::forward<TValue>(value));
+  }
+
+  static IValueToken* MakeCount(std::size_t count) { return makeNativeValue(static_cast<NativeArithmeticType>(count)); }
+
+  static NativeArithmeticType ToArithmetic(const IValueToken* value) { return toNative(value); }
+
+  static bool IsVector(const IValueToken* value) { return isVector(value); }
+
+  static const NativeVectorType& ToVector(const IValueToken* value) { return toVector(value); }
+
+  template<class TFunction>
+  static IValueToken* Broadcast(const IValueToken* value, const TFunction& function)
+  {
+    return broadcast(value, function);
+  }
+
+  template<class TFunction>
+  static IValueToken* Broadcast(const IValueToken* lhs, const IValueToken* rhs, const TFunction& function)
+  {
+    return broadcast(lhs, rhs, function);
+  }
+
+  static std::vector<NativeArithmeticType> ToArithmeticVector(const std::vector<IValueToken*>& args) { return toNativeVector(args); }
+
+  static const std::vector<NativeArithmeticType>& ToArithmeticVector(const std::vector<IValueToken*>& args, std::vector<NativeArithmeticType>& buffer)
+  {
+    return toNativeVector(args, buffer);
+  }
+
+  static NativeArithmeticType Min(const std::vector<NativeArithmeticType>& values) { return vectorMin(values.data(), values.size()); }
+
+  static NativeArithmeticType Max(const std::vector<NativeArithmeticType>& values) { return vectorMax(values.data(), values.size()); }
+
+  static NativeArithmeticType Mean(const std::vector<NativeArithmeticType>& values)
+  {
+    return vectorSum(values.data(), values.size()) / static_cast<NativeArithmeticType>(values.size());
+  }
+
+  static RunningVariance<NativeArithmeticType> Variance(const std::vector<NativeArithmeticType>& values)
+  {
+    RunningVariance<NativeArithmeticType> result;
+    for(const auto& i : values)
+    {
+      result.Push(i);
+    }
+
+    return result;
+  }
+
+  // Native constants are cheap, so they are computed up front.
+  static void AddConstant(NativeArithmeticType (*generator)(), const std::string& identifier, const char* title, const char* description)
+  {
+    addVariable<NativeVariableType>(generator(), identifier, title, description);
+  }
+
+  static constexpr UnaryOperatorCallbackType UnaryOperator_Not                   = ::UnaryOperator_Not;
+  static constexpr UnaryOperatorCallbackType UnaryOperator_Plus                  = ::UnaryOperator_Plus;
+  static constexpr UnaryOperatorCallbackType UnaryOperator_Minus                 = ::UnaryOperator_Minus;
+  static constexpr UnaryOperatorCallbackType UnaryOperator_Factorial             = ::UnaryOperator_Factorial;
+  static constexpr UnaryOperatorCallbackType UnaryOperator_BitwiseOnesComplement = ::UnaryOperator_BitwiseOnesComplement;
+
+  static constexpr BinaryOperatorCallbackType BinaryOperator_Equals             = ::BinaryOperator_Equals;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_NotEquals          = ::BinaryOperator_NotEquals;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_Lesser             = ::BinaryOperator_Lesser;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_Greater            = ::BinaryOperator_Greater;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_LesserOrEquals     = ::BinaryOperator_LesserOrEquals;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_GreaterOrEquals    = ::BinaryOperator_GreaterOrEquals;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_LogicalOr          = ::BinaryOperator_LogicalOr;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_LogicalAnd         = ::BinaryOperator_LogicalAnd;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_Addition           = ::BinaryOperator_Addition;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_Subtraction        = ::BinaryOperator_Subtraction;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_Multiplication     = ::BinaryOperator_Multiplication;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_Division           = ::BinaryOperator_Division;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_TruncatedDivision  = ::BinaryOperator_TruncatedDivision;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_Fmod               = ::BinaryOperator_Fmod;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_Remainder          = ::BinaryOperator_Remainder;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_Exponentiation     = ::BinaryOperator_Exponentiation;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_BitwiseOr          = ::BinaryOperator_BitwiseOr;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_BitwiseAnd         = ::BinaryOperator_BitwiseAnd;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_BitwiseXor         = ::BinaryOperator_BitwiseXor;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_BitwiseLeftShift   = ::BinaryOperator_BitwiseLeftShift;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_BitwiseRightShift  = ::BinaryOperator_BitwiseRightShift;
+  static constexpr BinaryOperatorCallbackType BinaryOperator_VariableAssignment = ::BinaryOperator_VariableAssignment;
+
+  static constexpr FunctionCallbackType Function_Abs      = ::Function_Abs;
+  static constexpr FunctionCallbackType Function_Neg      = ::Function_Neg;
+  static constexpr FunctionCallbackType Function_NegAbs   = ::Function_NegAbs<NativeArithmeticType>;
+  static constexpr FunctionCallbackType Function_Sqrt     = ::Function_Sqrt;
+  static constexpr FunctionCallbackType Function_Binom    = ::Function_Binom<NativeArithmeticType>;
+  static constexpr FunctionCallbackType Function_Multinom = ::Function_Multinom<NativeArithmeticType>;
+};
+
+void InitNativeExpressionParser(ExpressionParser& instance, KalkContext& context)
+{
+  const KalkContext::Scope scope(context);
+  if(context.options.jpo_precedence != 0)
+  {
+    context.defaultJuxtapositionOperator =
+        std::make_unique<BinaryOperatorToken>("*", BinaryOperator_Multiplication, 6 + context.options.jpo_precedence, Associativity::Left);
+  }
+
+  instance.SetOnParseNumberCallback(numberConverter);
+  instance.SetOnParseStringCallback(stringConverter);
+  instance.SetOnUnknownIdentifierCallback(addUninitializedVariable<NativeVariableType>);
+  instance.SetJuxtapositionOperator(context.defaultJuxtapositionOperator.get());
+
+  context.defaultNumberConverter           = numberConverter;
+  context.defaultStringConverter           = stringConverter;
+  context.defaultUnknownIdentifierCallback = addUninitializedVariable<NativeVariableType>;
+  context.defaultJuxtapositionCallback     = BinaryOperator_Multiplication;
+
+  instance.SetUnaryOperators(&context.defaultUnaryOperators);
+  instance.SetBinaryOperators(&context.defaultBinaryOperators);
+  instance.SetFunctions(&context.defaultFunctions);
+  instance.SetVariables(&context.defaultVariables);
+
+  addNumericOperators<NativeArithmeticType>();
+  addNumericFunctions<NativeArithmeticType>();
+  addStringFunctions<NativeArithmeticType>();
+
+  addVariable<NativeVariableType>(nullptr, "null", "Null", "Represents an undefined value type");
+  addVariable<NativeVariableType>(nullptr, "nil", "Nil", "Represents an undefined value type");
+  addVariable<NativeVariableType>(nullptr, "none", "None", "Represents an undefined value type");
+  addVariable<NativeVariableType>(std::numeric_limits<NativeArithmeticType>::quiet_NaN(), "nan", "Not a number", "Represents an undefined numeric value");
+  addVariable<NativeVariableType>(std::numeric_limits<NativeArithmeticType>::infinity(), "inf", "Infinity", "Represents infinity");
+  addVariable<NativeVariableType>(NativeArithmeticType(1), "true", "True", "Boolean value");
+  addVariable<NativeVariableType>(NativeArithmeticType(0), "false", "False", "Boolean value");
+  context.variableInfoMap.push_back(std::make_tuple("", "", ""));
+
+  addVariable<NativeVariableType>(NativeArithmeticType(M_PI), "math.pi", "Pi", "Mathematical constant");
+  addVariable<NativeVariableType>(NativeArithmeticType(0.57721566490153286060), "math.E", "Euler-Mascheroni constant", "Mathematical constant");
+  addVariable<NativeVariableType>(NativeArithmeticType(0.91596559417721901505), "math.catalan", "Catalan's constant", "Mathematical constant");
+  addVariable<NativeVariableType>(NativeArithmeticType(M_LN2), "math.ln2", "Logarithm of 2", "Mathematical constant");
+  addVariable<NativeVariableType>(NativeArithmeticType(M_E), "math.e", "Euler's number", "Mathematical constant");
+  context.variableInfoMap.push_back(std::make_tuple("", "", ""));
+
+  addNumericPrefixes<NativeArithmeticType>();
+
+  addVariable<NativeVariableType>(NativeArithmeticType(CHAR_BIT), "bpB", "Bits per byte", "Common value for number of bits per byte");
+  addVariable<NativeVariableType>(static_cast<NativeArithmeticType>(std::numeric_limits<std::int32_t>::min()),
+                                  "i32.min",
+                                  "Signed int min",
+                                  "32 bit signed integer min. limit");
+  addVariable<NativeVariableType>(static_cast<NativeArithmeticType>(std::numeric_limits<std::int32_t>::max()),
+                                  "i32.max",
+                                  "Signed int max",
+                                  "32 bit signed integer max. limit");
+  addVariable<NativeVariableType>(static_cast<NativeArithmeticType>(std::numeric_limits<std::uint32_t>::max()),
+                                  "u32.max",
+                                  "Unsigned int max",
+                                  "32 bit unsigned integer max. limit");
+  addVariable<NativeVariableType>(static_cast<NativeArithmeticType>(std::numeric_limits<float>::epsilon()),
+                                  "f32.epsilon",
+                                  "Float epsilon",
+                                  "32 bit floating point epsilon");
+  addVariable<NativeVariableType>(std::numeric_limits<double>::min(), "f64.min", "Double min", "64 bit floating point min. limit");
+  addVariable<NativeVariableType>(std::numeric_limits<double>::max(), "f64.max", "Double max", "64 bit floating point max. limit");
+  addVariable<NativeVariableType>(std::numeric_limits<double>::epsilon(), "f64.epsilon", "Double epsilon", "64 bit floating point epsilon");
+
+  context.IndexSymbols();
+}
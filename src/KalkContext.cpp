@@ -0,0 +1,68 @@
+#include "KalkContext.hpp"
+
+#include <stdexcept>
+
+static thread_local KalkContext* boundContext = nullptr;
+
+KalkContext::Scope::Scope(KalkContext& context)
+    : m_Previous(boundContext)
+    , m_PreviousPrecision(mpfr::mpreal::get_default_prec())
+    , m_PreviousRoundingMode(mpfr::mpreal::get_default_rnd())
+{
+  boundContext = &context;
+  context.ApplyPrecision();
+}
+
+KalkContext::Scope::~Scope()
+{
+  boundContext = m_Previous;
+  mpfr::mpreal::set_default_prec(m_PreviousPrecision);
+  mpfr::mpreal::set_default_rnd(m_PreviousRoundingMode);
+}
+
+KalkContext::KalkContext()
+    : options(defaultOptions)
+    , expressionCache(defaultOptions.cache_size)
+    , resultCache(defaultOptions.memo_size)
+{}
+
+void KalkContext::ApplyPrecision() const
+{
+  mpfr::mpreal::set_default_prec(options.precision);
+  mpfr::mpreal::set_default_rnd(options.roundingMode);
+}
+
+void KalkContext::IndexSymbols()
+{
+  std::vector<PerfectHashMap<FunctionIndexEntry>::EntryType> functions;
+  for(const auto& i : defaultFunctions)
+  {
+    const auto callback = defaultFunctionCallbacks.find(i.first);
+    if(callback != defaultFunctionCallbacks.cend())
+    {
+      functions.emplace_back(i.first, FunctionIndexEntry(i.second, &callback->second));
+    }
+  }
+
+  defaultFunctionIndex.Build(functions);
+
+  defaultBinaryOperatorIndex.Clear();
+  for(const auto& i : defaultBinaryOperators)
+  {
+    const auto callback = defaultBinaryOperatorCallbacks.find(i.first);
+    if(callback != defaultBinaryOperatorCallbacks.cend())
+    {
+      defaultBinaryOperatorIndex.Insert(i.first, BinaryOperatorIndexEntry(i.second, &callback->second));
+    }
+  }
+}
+
+KalkContext& currentContext()
+{
+  if(boundContext == nullptr)
+  {
+    throw std::logic_error("No context bound to the current thread");
+  }
+
+  return *boundContext;
+}
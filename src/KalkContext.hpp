@@ -0,0 +1,92 @@
+#ifndef __KALKCONTEXT_HPP__
+#define __KALKCONTEXT_HPP__
+
+#include "CallStatistics.hpp"
+#include "CompiledExpression.hpp"
+#include "ConstantCache.hpp"
+#include "OperatorTrie.hpp"
+#include "PerfectHashMap.hpp"
+#include "ResultHistory.hpp"
+#include "Setup.hpp"
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using FunctionIndexEntry       = std::pair<const IFunctionToken*, const FunctionToken::CallbackType*>;
+using BinaryOperatorIndexEntry = std::pair<const IBinaryOperatorToken*, const BinaryOperatorToken::CallbackType*>;
+
+struct KalkContext
+{
+  class Scope
+  {
+    public:
+    explicit Scope(KalkContext& context);
+    ~Scope();
+
+    Scope(const Scope&)            = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    private:
+    KalkContext* m_Previous;
+    mpfr_prec_t m_PreviousPrecision;
+    mpfr_rnd_t m_PreviousRoundingMode;
+  };
+
+  KalkContext();
+
+  void ApplyPrecision() const;
+  void IndexSymbols();
+
+  kalk_options options;
+  bool quit = false;
+
+  std::unordered_map<char, std::unique_ptr<UnaryOperatorToken>> defaultUnaryOperatorCache;
+  std::unordered_map<char, IUnaryOperatorToken*> defaultUnaryOperators;
+
+  std::unordered_map<std::string, std::unique_ptr<BinaryOperatorToken>> defaultBinaryOperatorCache;
+  std::unordered_map<std::string, IBinaryOperatorToken*> defaultBinaryOperators;
+
+  std::unordered_map<std::string, std::unique_ptr<FunctionToken>> defaultFunctionCache;
+  std::unordered_map<std::string, IFunctionToken*> defaultFunctions;
+
+  std::unordered_map<char, UnaryOperatorToken::CallbackType> defaultUnaryOperatorCallbacks;
+  std::unordered_map<std::string, BinaryOperatorToken::CallbackType> defaultBinaryOperatorCallbacks;
+  std::unordered_map<std::string, FunctionToken::CallbackType> defaultFunctionCallbacks;
+
+  PerfectHashMap<FunctionIndexEntry> defaultFunctionIndex;
+  OperatorTrie<BinaryOperatorIndexEntry> defaultBinaryOperatorIndex;
+
+  ConverterCallbackType defaultNumberConverter;
+  ConverterCallbackType defaultStringConverter;
+  ConverterCallbackType defaultUnknownIdentifierCallback;
+  std::unique_ptr<BinaryOperatorToken> defaultJuxtapositionOperator;
+  BinaryOperatorToken::CallbackType defaultJuxtapositionCallback;
+
+  std::unordered_map<std::string, std::unique_ptr<IVariableToken>> defaultUninitializedVariableCache;
+  std::unordered_map<std::string, std::unique_ptr<IVariableToken>> defaultInitializedVariableCache;
+  std::unordered_map<std::string, IVariableToken*> defaultVariables;
+
+  ConstantCache constants;
+  ResultHistory results;
+
+  std::vector<std::tuple<const IUnaryOperatorToken*, std::string_view, std::string_view>> unaryOperatorInfoMap;
+  std::vector<std::tuple<const IBinaryOperatorToken*, std::string_view, std::string_view>> binaryOperatorInfoMap;
+  std::vector<std::tuple<const IFunctionToken*, std::string_view, std::string_view>> functionInfoMap;
+  std::vector<std::tuple<std::string, std::string_view, std::string_view>> variableInfoMap;
+
+  CallStatistics callStatistics;
+  ExpressionCache expressionCache;
+  ResultCache resultCache;
+  std::size_t variableGeneration = 0u;
+  ExpressionParser chemicalExpressionParser;
+  CommandParser::CallbackCollection commandCallbacks;
+};
+
+KalkContext& currentContext();
+
+#endif // __KALKCONTEXT_HPP__
@@ -0,0 +1,119 @@
+#include "LineReader.hpp"
+#include "Trace.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+LineReader::LineReader(int fileDescriptor, std::size_t blockSize)
+    : m_FileDescriptor(fileDescriptor)
+    , m_BlockSize(blockSize)
+{
+  struct stat fileStatus;
+  if(fstat(m_FileDescriptor, &fileStatus) == 0 && S_ISREG(fileStatus.st_mode) && fileStatus.st_size > 0)
+  {
+    const auto length = static_cast<std::size_t>(fileStatus.st_size);
+    void* mapping     = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, m_FileDescriptor, 0);
+    if(mapping != MAP_FAILED)
+    {
+      madvise(mapping, length, MADV_SEQUENTIAL);
+      m_Mapping = static_cast<char*>(mapping);
+      m_Length  = length;
+      return;
+    }
+  }
+
+  m_Buffer.resize(m_BlockSize);
+}
+
+LineReader::~LineReader()
+{
+  if(m_Mapping != nullptr)
+  {
+    munmap(m_Mapping, m_Length);
+  }
+}
+
+bool LineReader::Next(std::string_view& line)
+{
+  if(m_Mapping != nullptr)
+  {
+    if(m_Begin >= m_Length)
+    {
+      return false;
+    }
+
+    const auto begin   = m_Mapping + m_Begin;
+    const auto newline = static_cast<const char*>(std::memchr(begin, '\n', m_Length - m_Begin));
+    const auto length  = (newline != nullptr) ? static_cast<std::size_t>(newline - begin) : m_Length - m_Begin;
+    line               = std::string_view(begin, length);
+    m_Begin += length + 1u;
+    return true;
+  }
+
+  while(true)
+  {
+    const auto begin   = m_Buffer.data() + m_Begin;
+    const auto newline = static_cast<const char*>(std::memchr(begin, '\n', m_End - m_Begin));
+    if(newline != nullptr)
+    {
+      const auto length = static_cast<std::size_t>(newline - begin);
+      line              = std::string_view(begin, length);
+      m_Begin += length + 1u;
+      return true;
+    }
+
+    if(m_Eof)
+    {
+      if(m_Begin >= m_End)
+      {
+        return false;
+      }
+
+      line    = std::string_view(begin, m_End - m_Begin);
+      m_Begin = m_End;
+      return true;
+    }
+
+    Fill();
+  }
+}
+
+bool LineReader::Fill()
+{
+  const TraceSpan span("input", "read");
+  if(m_Begin > 0u)
+  {
+    std::memmove(m_Buffer.data(), m_Buffer.data() + m_Begin, m_End - m_Begin);
+    m_End -= m_Begin;
+    m_Begin = 0u;
+  }
+
+  if(m_End == m_Buffer.size())
+  {
+    m_Buffer.resize(m_Buffer.size() + m_BlockSize);
+  }
+
+  while(true)
+  {
+    const auto count = read(m_FileDescriptor, m_Buffer.data() + m_End, m_Buffer.size() - m_End);
+    if(count > 0)
+    {
+      m_End += static_cast<std::size_t>(count);
+      return true;
+    }
+    else if(count == 0)
+    {
+      m_Eof = true;
+      return false;
+    }
+    else if(errno != EINTR)
+    {
+      throw std::runtime_error(std::strerror(errno));
+    }
+  }
+}
@@ -0,0 +1,35 @@
+#ifndef __LINEREADER_HPP__
+#define __LINEREADER_HPP__
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+class LineReader
+{
+  public:
+  static constexpr std::size_t kDefaultBlockSize = 1u << 20u;
+
+  explicit LineReader(int fileDescriptor, std::size_t blockSize = kDefaultBlockSize);
+  ~LineReader();
+
+  LineReader(const LineReader&)            = delete;
+  LineReader& operator=(const LineReader&) = delete;
+
+  bool IsMapped() const { return m_Mapping != nullptr; }
+  bool Next(std::string_view& line);
+
+  private:
+  bool Fill();
+
+  int m_FileDescriptor;
+  std::size_t m_BlockSize;
+  char* m_Mapping      = nullptr;
+  std::size_t m_Length = 0u;
+  std::vector<char> m_Buffer;
+  std::size_t m_Begin = 0u;
+  std::size_t m_End   = 0u;
+  bool m_Eof          = false;
+};
+
+#endif // __LINEREADER_HPP__
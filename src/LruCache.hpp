@@ -0,0 +1,96 @@
+#ifndef __LRUCACHE_HPP__
+#define __LRUCACHE_HPP__
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+template<class TKey, class TValue, class THash = std::hash<TKey>>
+class LruCache
+{
+  public:
+  using EntryType = std::pair<TKey, TValue>;
+
+  explicit LruCache(std::size_t capacity = 0u)
+      : m_Capacity(capacity)
+  {}
+
+  std::size_t GetCapacity() const { return m_Capacity; }
+
+  void SetCapacity(std::size_t value)
+  {
+    m_Capacity = value;
+    Trim();
+  }
+
+  std::size_t GetSize() const { return m_Entries.size(); }
+  std::size_t GetHits() const { return m_Hits; }
+  std::size_t GetMisses() const { return m_Misses; }
+
+  const TValue* Find(const TKey& key)
+  {
+    auto iter = m_Index.find(key);
+    if(iter == m_Index.end())
+    {
+      m_Misses++;
+      return nullptr;
+    }
+
+    m_Hits++;
+    m_Entries.splice(m_Entries.begin(), m_Entries, iter->second);
+    return &iter->second->second;
+  }
+
+  const TValue* Insert(const TKey& key, TValue value)
+  {
+    if(m_Capacity == 0u)
+    {
+      return nullptr;
+    }
+
+    auto iter = m_Index.find(key);
+    if(iter != m_Index.end())
+    {
+      iter->second->second = std::move(value);
+      m_Entries.splice(m_Entries.begin(), m_Entries, iter->second);
+      return &iter->second->second;
+    }
+
+    m_Entries.emplace_front(key, std::move(value));
+    m_Index.emplace(m_Entries.front().first, m_Entries.begin());
+    Trim();
+    return &m_Entries.front().second;
+  }
+
+  void Clear()
+  {
+    m_Index.clear();
+    m_Entries.clear();
+  }
+
+  void ResetStatistics()
+  {
+    m_Hits   = 0u;
+    m_Misses = 0u;
+  }
+
+  private:
+  void Trim()
+  {
+    while(m_Entries.size() > m_Capacity)
+    {
+      m_Index.erase(m_Entries.back().first);
+      m_Entries.pop_back();
+    }
+  }
+
+  std::size_t m_Capacity;
+  std::size_t m_Hits   = 0u;
+  std::size_t m_Misses = 0u;
+  std::list<EntryType> m_Entries;
+  std::unordered_map<TKey, typename std::list<EntryType>::iterator, THash> m_Index;
+};
+
+#endif // __LRUCACHE_HPP__
@@ -0,0 +1,73 @@
+#include "NumericSetup.hpp"
+
+int digitValue(char value)
+{
+  if(value >= '0' && value <= '9')
+  {
+    return value - '0';
+  }
+  else if(value >= 'a' && value <= 'z')
+  {
+    return value - 'a' + 10;
+  }
+  else if(value >= 'A' && value <= 'Z')
+  {
+    return value - 'A' + 10;
+  }
+
+  return -1;
+}
+
+void addUnaryOperator(const UnaryOperatorToken::CallbackType& callback,
+                      char identifier,
+                      int precedence,
+                      Associativity associativity,
+                      const char* title,
+                      const char* description)
+{
+  auto& context                                     = currentContext();
+  const auto instrumented                           = context.callStatistics.Instrument(callback, "unary", std::string(1u, identifier));
+  auto tmpNew                                       = std::make_unique<UnaryOperatorToken>(identifier, instrumented, precedence, associativity);
+  auto tmp                                          = tmpNew.get();
+  context.defaultUnaryOperatorCache[identifier]     = std::move(tmpNew);
+  context.defaultUnaryOperators[identifier]         = tmp;
+  context.defaultUnaryOperatorCallbacks[identifier] = instrumented;
+
+  context.unaryOperatorInfoMap.push_back(std::make_tuple(tmp, title, description));
+}
+
+void addBinaryOperator(const BinaryOperatorToken::CallbackType& callback,
+                       const std::string& identifier,
+                       int precedence,
+                       Associativity associativity,
+                       const char* title,
+                       const char* description)
+{
+  auto& context                                      = currentContext();
+  const auto instrumented                            = context.callStatistics.Instrument(callback, "binary", identifier);
+  auto tmpNew                                        = std::make_unique<BinaryOperatorToken>(identifier, instrumented, precedence, associativity);
+  auto tmp                                           = tmpNew.get();
+  context.defaultBinaryOperatorCache[identifier]     = std::move(tmpNew);
+  context.defaultBinaryOperators[identifier]         = tmp;
+  context.defaultBinaryOperatorCallbacks[identifier] = instrumented;
+
+  context.binaryOperatorInfoMap.push_back(std::make_tuple(tmp, title, description));
+}
+
+void addFunction(const FunctionToken::CallbackType& callback,
+                 const std::string& identifier,
+                 std::size_t minArgs,
+                 std::size_t maxArgs,
+                 const char* title,
+                 const char* description)
+{
+  auto& context                                = currentContext();
+  const auto instrumented                      = context.callStatistics.Instrument(callback, "function", identifier);
+  auto tmpNew                                  = std::make_unique<FunctionToken>(identifier, instrumented, minArgs, maxArgs);
+  auto tmp                                     = tmpNew.get();
+  context.defaultFunctionCache[identifier]     = std::move(tmpNew);
+  context.defaultFunctions[identifier]         = tmp;
+  context.defaultFunctionCallbacks[identifier] = instrumented;
+
+  context.functionInfoMap.push_back(std::make_tuple(tmp, title, description));
+}
@@ -0,0 +1,878 @@
+#ifndef __NUMERICSETUP_HPP__
+#define __NUMERICSETUP_HPP__
+
+#include "Aggregates.hpp"
+#include "Combinatorics.hpp"
+#include "KalkContext.hpp"
+#include "Setup.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <mpfr.h>
+#include <mpreal.h>
+
+// Math functions of both arithmetic types under one name. Shared callbacks call them qualified, so overload resolution picks the MPFR function for mpreal
+// values and the libm one for doubles. Functions that libm lacks are derived from the ones it has.
+namespace NumericMath
+{
+using mpfr::abs;
+using mpfr::acos;
+using mpfr::acosh;
+using mpfr::acot;
+using mpfr::acoth;
+using mpfr::acsc;
+using mpfr::acsch;
+using mpfr::asec;
+using mpfr::asech;
+using mpfr::asin;
+using mpfr::asinh;
+using mpfr::atan;
+using mpfr::atan2;
+using mpfr::atanh;
+using mpfr::cbrt;
+using mpfr::ceil;
+using mpfr::cos;
+using mpfr::cosh;
+using mpfr::cot;
+using mpfr::coth;
+using mpfr::csc;
+using mpfr::csch;
+using mpfr::exp;
+using mpfr::exp10;
+using mpfr::exp2;
+using mpfr::floor;
+using mpfr::fmod;
+using mpfr::isfinite;
+using mpfr::log;
+using mpfr::log10;
+using mpfr::log2;
+using mpfr::pow;
+using mpfr::remainder;
+using mpfr::rint;
+using mpfr::round;
+using mpfr::sec;
+using mpfr::sech;
+using mpfr::sin;
+using mpfr::sinh;
+using mpfr::sqrt;
+using mpfr::tan;
+using mpfr::tanh;
+using mpfr::trunc;
+
+using std::abs;
+using std::acos;
+using std::acosh;
+using std::asin;
+using std::asinh;
+using std::atan;
+using std::atan2;
+using std::atanh;
+using std::cbrt;
+using std::ceil;
+using std::cos;
+using std::cosh;
+using std::exp;
+using std::exp2;
+using std::floor;
+using std::fmod;
+using std::isfinite;
+using std::log;
+using std::log10;
+using std::log2;
+using std::pow;
+using std::remainder;
+using std::round;
+using std::sin;
+using std::sinh;
+using std::sqrt;
+using std::tan;
+using std::tanh;
+using std::trunc;
+
+inline double cot(double x) { return 1 / std::tan(x); }
+inline double sec(double x) { return 1 / std::cos(x); }
+inline double csc(double x) { return 1 / std::sin(x); }
+inline double acot(double x) { return std::atan(1 / x); }
+inline double asec(double x) { return std::acos(1 / x); }
+inline double acsc(double x) { return std::asin(1 / x); }
+inline double coth(double x) { return 1 / std::tanh(x); }
+inline double sech(double x) { return 1 / std::cosh(x); }
+inline double csch(double x) { return 1 / std::sinh(x); }
+inline double acoth(double x) { return std::atanh(1 / x); }
+inline double asech(double x) { return std::acosh(1 / x); }
+inline double acsch(double x) { return std::asinh(1 / x); }
+inline double exp10(double x) { return std::pow(10.0, x); }
+
+// Third power of x. Doubles multiply twice, as the native engine always has, rather than taking pow(x, 3).
+inline double cube(double x) { return x * x * x; }
+inline mpfr::mpreal cube(const mpfr::mpreal& x) { return mpfr::pow(x, 3); }
+
+// Rounds to an integer in the specified MPFR rounding mode.
+inline double rint(double x, mpfr_rnd_t mode)
+{
+  switch(mode)
+  {
+    case mpfr_rnd_t::MPFR_RNDZ:
+      return std::trunc(x);
+    case mpfr_rnd_t::MPFR_RNDU:
+      return std::ceil(x);
+    case mpfr_rnd_t::MPFR_RNDD:
+      return std::floor(x);
+    case mpfr_rnd_t::MPFR_RNDA:
+      return x < 0 ? std::floor(x) : std::ceil(x);
+    case mpfr_rnd_t::MPFR_RNDNA:
+      return std::round(x);
+    default:
+      return std::nearbyint(x);
+  }
+}
+
+// Non-negative integral value as an element count.
+inline std::size_t toSize(double x) { return static_cast<std::size_t>(x); }
+inline std::size_t toSize(const mpfr::mpreal& x) { return static_cast<std::size_t>(x.toULong()); }
+} // namespace NumericMath
+
+// Value types and helpers of the engine computing in T. Each engine specializes this before registering the shared operators and functions:
+//   ValueType, VectorType, ModeHash
+//   MakeValue(value), MakeCount(count), ToArithmetic(token), IsVector(token), ToVector(token)
+//   Broadcast(token, function), Broadcast(lhs, rhs, function), ToArithmeticVector(args[, buffer]), Min/Max/Mean/Variance(values)
+//   AddConstant(generator, identifier, title, description)
+// It also names the callbacks that the lists below register but that differ between the engines: every operator, and Function_Abs, Function_Neg,
+// Function_NegAbs, Function_Sqrt, Function_Binom and Function_Multinom. Engines without a specialized version point the last four at the templates here.
+template<class T>
+struct NumericTraits;
+
+// Value of a digit in bases up to 36, or -1 if value is not a digit.
+int digitValue(char value);
+
+using UnaryOperatorCallbackType  = IValueToken* (*)(IValueToken*);
+using BinaryOperatorCallbackType = IValueToken* (*)(IValueToken*, IValueToken*);
+using FunctionCallbackType       = IValueToken* (*)(const std::vector<IValueToken*>&);
+
+void addUnaryOperator(const UnaryOperatorToken::CallbackType& callback,
+                      char identifier,
+                      int precedence,
+                      Associativity associativity,
+                      const char* title       = "",
+                      const char* description = "");
+void addBinaryOperator(const BinaryOperatorToken::CallbackType& callback,
+                       const std::string& identifier,
+                       int precedence,
+                       Associativity associativity,
+                       const char* title       = "",
+                       const char* description = "");
+void addFunction(const FunctionToken::CallbackType& callback,
+                 const std::string& identifier,
+                 std::size_t minArgs     = 0u,
+                 std::size_t maxArgs     = FunctionToken::GetArgumentCountMaxLimit(),
+                 const char* title       = "",
+                 const char* description = "");
+
+template<class TVariable, class T>
+void addVariable(const T& value, const std::string& identifier, const char* title = "", const char* description = "")
+{
+  auto& context                                       = currentContext();
+  auto tmpNew                                         = std::make_unique<TVariable>(identifier, value);
+  auto tmp                                            = tmpNew.get();
+  context.defaultInitializedVariableCache[identifier] = std::move(tmpNew);
+  context.defaultVariables[identifier]                = tmp;
+
+  context.variableInfoMap.push_back(std::make_tuple(identifier, title, description));
+}
+
+template<class TVariable>
+TVariable* addUninitializedVariable(const std::string& identifier)
+{
+  auto& context                                         = currentContext();
+  auto tmpNew                                           = std::make_unique<TVariable>(identifier);
+  auto result                                           = tmpNew.get();
+  context.defaultUninitializedVariableCache[identifier] = std::move(tmpNew);
+  context.defaultVariables[identifier]                  = result;
+  return result;
+}
+
+template<class T, long TExponent>
+T powerOfTen() { return NumericMath::exp10(T(TExponent)); }
+
+template<class T, long TExponent>
+T powerOfTwo() { return NumericMath::exp2(T(TExponent)); }
+
+#ifndef __REGION__FUNCTIONS
+#ifndef __REGION__FUNCTIONS__COMMON
+template<class T>
+IValueToken* Function_Sgn(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return T((x > 0) - (x < 0)); });
+}
+
+template<class T>
+IValueToken* Function_NegAbs(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return -NumericMath::abs(x); });
+}
+
+template<class T>
+IValueToken* Function_Round(const std::vector<IValueToken*>& args)
+{
+  using ValueType             = typename NumericTraits<T>::ValueType;
+  const mpfr_rnd_t tmpRndMode = args.size() > 1u ? strToRmode(args[1]->As<ValueType*>()->template GetValue<std::string>()) : mpfr::mpreal::get_default_rnd();
+  return NumericTraits<T>::Broadcast(args[0], [tmpRndMode](const T& x) { return NumericMath::rint(x, tmpRndMode); });
+}
+
+template<class T>
+IValueToken* Function_RoundE(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::rint(x, mpfr_rnd_t::MPFR_RNDN); });
+}
+
+template<class T>
+IValueToken* Function_RoundA(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::round(x); });
+}
+
+template<class T>
+IValueToken* Function_Ceil(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::ceil(x); });
+}
+
+template<class T>
+IValueToken* Function_Floor(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::floor(x); });
+}
+
+template<class T>
+IValueToken* Function_Trunc(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::trunc(x); });
+}
+#endif // __REGION__FUNCTIONS__COMMON
+
+#ifndef __REGION__FUNCTIONS__ARITHMETIC
+template<class T>
+IValueToken* Function_Fmod(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], args[1], [](const T& x, const T& y) { return NumericMath::fmod(x, y); });
+}
+
+template<class T>
+IValueToken* Function_Rem(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], args[1], [](const T& x, const T& y) { return NumericMath::remainder(x, y); });
+}
+
+template<class T>
+IValueToken* Function_Mod(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], args[1], [](const T& x, const T& y) { return x - (NumericMath::floor(x / y) * y); });
+}
+
+template<class T>
+IValueToken* Function_Pow(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], args[1], [](const T& x, const T& y) { return NumericMath::pow(x, y); });
+}
+
+template<class T>
+IValueToken* Function_Sqr(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::pow(x, 2); });
+}
+
+template<class T>
+IValueToken* Function_Cb(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::cube(x); });
+}
+
+template<class T>
+IValueToken* Function_Root(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], args[1], [](const T& x, const T& y) { return NumericMath::pow(x, 1 / y); });
+}
+
+template<class T>
+IValueToken* Function_Sqrt(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::sqrt(x); });
+}
+
+template<class T>
+IValueToken* Function_Cbrt(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::cbrt(x); });
+}
+
+template<class T>
+IValueToken* Function_Exp(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::exp(x); });
+}
+
+template<class T>
+IValueToken* Function_Exp2(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::exp2(x); });
+}
+
+template<class T>
+IValueToken* Function_Exp10(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::exp10(x); });
+}
+
+template<class T>
+IValueToken* Function_LogN(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], args[1], [](const T& x, const T& y) { return NumericMath::log(x) / NumericMath::log(y); });
+}
+
+template<class T>
+IValueToken* Function_Log(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::log(x); });
+}
+
+template<class T>
+IValueToken* Function_Log2(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::log2(x); });
+}
+
+template<class T>
+IValueToken* Function_Log10(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::log10(x); });
+}
+#endif // __REGION__FUNCTIONS__ARITHMETIC
+
+#ifndef __REGION__FUNCTIONS__TRIGONOMETRY
+template<class T>
+IValueToken* Function_Sin(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::sin(x); });
+}
+
+template<class T>
+IValueToken* Function_Cos(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::cos(x); });
+}
+
+template<class T>
+IValueToken* Function_Tan(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::tan(x); });
+}
+
+template<class T>
+IValueToken* Function_Cot(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::cot(x); });
+}
+
+template<class T>
+IValueToken* Function_Sec(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::sec(x); });
+}
+
+template<class T>
+IValueToken* Function_Csc(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::csc(x); });
+}
+
+template<class T>
+IValueToken* Function_ASin(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::asin(x); });
+}
+
+template<class T>
+IValueToken* Function_ACos(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::acos(x); });
+}
+
+template<class T>
+IValueToken* Function_ATan(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::atan(x); });
+}
+
+template<class T>
+IValueToken* Function_ATan2(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], args[1], [](const T& x, const T& y) { return NumericMath::atan2(x, y); });
+}
+
+template<class T>
+IValueToken* Function_ACot(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::acot(x); });
+}
+
+template<class T>
+IValueToken* Function_ASec(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::asec(x); });
+}
+
+template<class T>
+IValueToken* Function_ACsc(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::acsc(x); });
+}
+
+template<class T>
+IValueToken* Function_SinH(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::sinh(x); });
+}
+
+template<class T>
+IValueToken* Function_CosH(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::cosh(x); });
+}
+
+template<class T>
+IValueToken* Function_TanH(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::tanh(x); });
+}
+
+template<class T>
+IValueToken* Function_CotH(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::coth(x); });
+}
+
+template<class T>
+IValueToken* Function_SecH(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::sech(x); });
+}
+
+template<class T>
+IValueToken* Function_CscH(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::csch(x); });
+}
+
+template<class T>
+IValueToken* Function_ASinH(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::asinh(x); });
+}
+
+template<class T>
+IValueToken* Function_ACosH(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::acosh(x); });
+}
+
+template<class T>
+IValueToken* Function_ATanH(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::atanh(x); });
+}
+
+template<class T>
+IValueToken* Function_ACotH(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::acoth(x); });
+}
+
+template<class T>
+IValueToken* Function_ASecH(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::asech(x); });
+}
+
+template<class T>
+IValueToken* Function_ACscH(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], [](const T& x) { return NumericMath::acsch(x); });
+}
+#endif // __REGION__FUNCTIONS__TRIGONOMETRY
+
+#ifndef __REGION__FUNCTIONS__AGGREGATES
+template<class T>
+IValueToken* Function_Min(const std::vector<IValueToken*>& args)
+{
+  std::vector<T> buffer;
+  return NumericTraits<T>::MakeValue(NumericTraits<T>::Min(NumericTraits<T>::ToArithmeticVector(args, buffer)));
+}
+
+template<class T>
+IValueToken* Function_Max(const std::vector<IValueToken*>& args)
+{
+  std::vector<T> buffer;
+  return NumericTraits<T>::MakeValue(NumericTraits<T>::Max(NumericTraits<T>::ToArithmeticVector(args, buffer)));
+}
+
+template<class T>
+IValueToken* Function_Mean(const std::vector<IValueToken*>& args)
+{
+  std::vector<T> buffer;
+  return NumericTraits<T>::MakeValue(NumericTraits<T>::Mean(NumericTraits<T>::ToArithmeticVector(args, buffer)));
+}
+
+template<class T>
+IValueToken* Function_Median(const std::vector<IValueToken*>& args)
+{
+  auto values = NumericTraits<T>::ToArithmeticVector(args);
+  return NumericTraits<T>::MakeValue(selectMedian(values, 0u, values.size()));
+}
+
+// Values in each half of the sorted sequence that the quartiles are the medians of. An odd count leaves the median out of both halves, and a single
+// value makes up both.
+inline std::size_t quartileHalfSize(std::size_t count) { return std::max<std::size_t>(count / 2u, 1u); }
+
+template<class T>
+IValueToken* Function_Quartile_Lower(const std::vector<IValueToken*>& args)
+{
+  auto values = NumericTraits<T>::ToArithmeticVector(args);
+  return NumericTraits<T>::MakeValue(selectMedian(values, 0u, quartileHalfSize(values.size())));
+}
+
+template<class T>
+IValueToken* Function_Quartile_Upper(const std::vector<IValueToken*>& args)
+{
+  auto values             = NumericTraits<T>::ToArithmeticVector(args);
+  const std::size_t count = quartileHalfSize(values.size());
+  return NumericTraits<T>::MakeValue(selectMedian(values, values.size() - count, count));
+}
+
+template<class T>
+IValueToken* Function_Mode(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::MakeValue(selectMode<T, typename NumericTraits<T>::ModeHash>(NumericTraits<T>::ToArithmeticVector(args)));
+}
+
+template<class T>
+IValueToken* Function_StdDev(const std::vector<IValueToken*>& args)
+{
+  std::vector<T> buffer;
+  return NumericTraits<T>::MakeValue(NumericMath::sqrt(NumericTraits<T>::Variance(NumericTraits<T>::ToArithmeticVector(args, buffer)).GetVariance()));
+}
+#endif // __REGION__FUNCTIONS__AGGREGATES
+
+#ifndef __REGION__FUNCTIONS__COMBINATORICS
+template<class T>
+IValueToken* Function_Binom(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::Broadcast(args[0], args[1], [](const T& x, const T& y) { return binomial(x, y); });
+}
+
+template<class T>
+IValueToken* Function_Multinom(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::MakeValue(multinomial(NumericTraits<T>::ToArithmeticVector(args)));
+}
+#endif // __REGION__FUNCTIONS__COMBINATORICS
+
+#ifndef __REGION__FUNCTIONS__VECTOR
+template<class T>
+IValueToken* Function_Vec(const std::vector<IValueToken*>& args)
+{
+  typename NumericTraits<T>::VectorType result;
+  for(const auto& i : args)
+  {
+    if(NumericTraits<T>::IsVector(i))
+    {
+      const auto& elements = NumericTraits<T>::ToVector(i).GetElements();
+      result.GetElements().insert(result.GetElements().end(), elements.cbegin(), elements.cend());
+    }
+    else
+    {
+      result.GetElements().push_back(NumericTraits<T>::ToArithmetic(i));
+    }
+  }
+
+  return NumericTraits<T>::MakeValue(std::move(result));
+}
+
+template<class T>
+IValueToken* Function_VecRange(const std::vector<IValueToken*>& args)
+{
+  const T start = args.size() > 1u ? NumericTraits<T>::ToArithmetic(args[0]) : T(0);
+  const T stop  = args.size() > 1u ? NumericTraits<T>::ToArithmetic(args[1]) : NumericTraits<T>::ToArithmetic(args[0]);
+  const T step  = args.size() > 2u ? NumericTraits<T>::ToArithmetic(args[2]) : T(1);
+  if(step == 0 || !NumericMath::isfinite(start) || !NumericMath::isfinite(stop) || !NumericMath::isfinite(step))
+  {
+    throw std::domain_error("Range bounds and step must be finite, with a non-zero step");
+  }
+
+  const T count = NumericMath::ceil((stop - start) / step);
+  typename NumericTraits<T>::VectorType result(count > 0 ? NumericMath::toSize(count) : 0u);
+  for(std::size_t i = 0u; i < result.GetSize(); i++)
+  {
+    result[i] = start + step * static_cast<T>(i);
+  }
+
+  return NumericTraits<T>::MakeValue(std::move(result));
+}
+
+template<class T>
+IValueToken* Function_VecLen(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::MakeCount(NumericTraits<T>::IsVector(args[0]) ? NumericTraits<T>::ToVector(args[0]).GetSize() : 1u);
+}
+#endif // __REGION__FUNCTIONS__VECTOR
+
+#ifndef __REGION__FUNCTIONS__STRING
+template<class T>
+IValueToken* Function_Str(const std::vector<IValueToken*>& args)
+{
+  return NumericTraits<T>::MakeValue(args[0]->ToString());
+}
+
+template<class T>
+IValueToken* Function_StrLen(const std::vector<IValueToken*>& args)
+{
+  using ValueType = typename NumericTraits<T>::ValueType;
+  return NumericTraits<T>::MakeValue(static_cast<T>(args[0]->As<ValueType*>()->template GetValue<std::string>().length()));
+}
+#endif // __REGION__FUNCTIONS__STRING
+#endif // __REGION__FUNCTIONS
+
+// Operators of both engines, in listing order.
+template<class T>
+void addNumericOperators()
+{
+  using Traits  = NumericTraits<T>;
+  auto& context = currentContext();
+
+  addUnaryOperator(Traits::UnaryOperator_Not, '!', 9, Associativity::Right, "Not", "!x");
+  context.unaryOperatorInfoMap.push_back(std::make_tuple(nullptr, "", ""));
+  addUnaryOperator(Traits::UnaryOperator_Plus, '+', 9, Associativity::Right, "Unary plus", "+x");
+  addUnaryOperator(Traits::UnaryOperator_Minus, '-', 9, Associativity::Right, "Unary minus", "-x");
+  addUnaryOperator(Traits::UnaryOperator_Factorial, ':', 9, Associativity::Right, "Factorial", ":x = x!");
+  addUnaryOperator(Traits::UnaryOperator_BitwiseOnesComplement, '~', 9, Associativity::Right, "One\'s complement", "Invert bits");
+
+  addBinaryOperator(Traits::BinaryOperator_Equals, "==", 3, Associativity::Left, "Equals", "x == y");
+  addBinaryOperator(Traits::BinaryOperator_NotEquals, "!=", 3, Associativity::Left, "Not equals", "x != y");
+  addBinaryOperator(Traits::BinaryOperator_Lesser, "<", 3, Associativity::Left, "Lesser", "x < y");
+  addBinaryOperator(Traits::BinaryOperator_Greater, ">", 3, Associativity::Left, "Greater", "x > y");
+  addBinaryOperator(Traits::BinaryOperator_LesserOrEquals, "<=", 3, Associativity::Left, "Lesser or equal", "x <= y");
+  addBinaryOperator(Traits::BinaryOperator_GreaterOrEquals, ">=", 3, Associativity::Left, "Greater or equal", "x >= y");
+  context.binaryOperatorInfoMap.push_back(std::make_tuple(nullptr, "", ""));
+
+  addBinaryOperator(Traits::BinaryOperator_LogicalOr, "||", 1, Associativity::Left, "Logical OR", "x || y");
+  addBinaryOperator(Traits::BinaryOperator_LogicalAnd, "&&", 1, Associativity::Left, "Logical AND", "x && y");
+  context.binaryOperatorInfoMap.push_back(std::make_tuple(nullptr, "", ""));
+
+  addBinaryOperator(Traits::BinaryOperator_Addition, "+", 4, Associativity::Left, "Addition", "x + y");
+  addBinaryOperator(Traits::BinaryOperator_Subtraction, "-", 4, Associativity::Left, "Subtraction", "x - y");
+  addBinaryOperator(Traits::BinaryOperator_Multiplication, "*", 6, Associativity::Left, "Multiplication", "x * y");
+  addBinaryOperator(Traits::BinaryOperator_Division, "/", 6, Associativity::Left, "Division", "x / y");
+  addBinaryOperator(Traits::BinaryOperator_TruncatedDivision,
+                    "//",
+                    6,
+                    Associativity::Left,
+                    "Truncated division",
+                    "Division with the quotient\'s fractional part truncated");
+  addBinaryOperator(Traits::BinaryOperator_Fmod, "%", 6, Associativity::Left, "Floating point modulo", "Returns the remainder of x / y (Using truncation)");
+  addBinaryOperator(Traits::BinaryOperator_Remainder, "%%", 6, Associativity::Left, "Remainder", "Returns the remainder of x / y (Using round to nearest)");
+  addBinaryOperator(Traits::BinaryOperator_Exponentiation, "**", 8, Associativity::Right, "Power", "Returns x to the power of y");
+  context.binaryOperatorInfoMap.push_back(std::make_tuple(nullptr, "", ""));
+
+  addBinaryOperator(Traits::BinaryOperator_BitwiseOr, "|", 2, Associativity::Left, "Bitwise OR", "x | y");
+  addBinaryOperator(Traits::BinaryOperator_BitwiseAnd, "&", 2, Associativity::Left, "Bitwise AND", "x & y");
+  addBinaryOperator(Traits::BinaryOperator_BitwiseXor, "^", 2, Associativity::Left, "Bitwise XOR", "x ^ y");
+  addBinaryOperator(Traits::BinaryOperator_BitwiseLeftShift, "<<", 2, Associativity::Left, "Bitwise left shift", "Shift bits n steps to the left");
+  addBinaryOperator(Traits::BinaryOperator_BitwiseRightShift, ">>", 2, Associativity::Left, "Bitwise right shift", "Shift bits n steps to the right");
+  context.binaryOperatorInfoMap.push_back(std::make_tuple(nullptr, "", ""));
+
+  addBinaryOperator(Traits::BinaryOperator_VariableAssignment, "=", 10, Associativity::Right, "Assignment", "Assigns variable");
+}
+
+// Numeric functions of both engines, from sgn through vec.len, in listing order.
+template<class T>
+void addNumericFunctions()
+{
+  using Traits  = NumericTraits<T>;
+  auto& context = currentContext();
+
+  addFunction(Function_Sgn<T>, "sgn", 1u, 1u, "Sign", "Returns the sign (-1, 0, 1)");
+  addFunction(Traits::Function_Abs, "abs", 1u, 1u, "Absolute value", "Returns the absolute value");
+  addFunction(Traits::Function_Neg, "neg", 1u, 1u, "Negate", "Returns the negated value");
+  addFunction(Traits::Function_NegAbs, "negabs", 1u, 1u, "Negate absolute value", "Returns the negated absolute value");
+  addFunction(Function_Round<T>, "round", 1u, 2u, "Round", "Round a value according to second argument or the default rounding mode");
+  addFunction(Function_RoundE<T>, "rounde", 1u, 1u, "Round even", "Round a value with halfway cases to nearest even number");
+  addFunction(Function_RoundA<T>, "rounda", 1u, 1u, "Round away", "Round a value with halfway cases away from zero");
+  addFunction(Function_Ceil<T>, "ceil", 1u, 1u, "Ceil", "Round a value towards higher or equal number");
+  addFunction(Function_Floor<T>, "floor", 1u, 1u, "Floor", "Round a value towards lower or equal number");
+  addFunction(Function_Trunc<T>, "trunc", 1u, 1u, "Truncation", "Truncates the fractional part (Round towards zero)");
+  context.functionInfoMap.push_back(std::make_tuple(nullptr, "", ""));
+
+  addFunction(Function_Fmod<T>, "math.fmod", 2u, 2u, "Floating point modulo", "Returns the remainder of x / y (Using truncation)");
+  addFunction(Function_Rem<T>, "math.rem", 2u, 2u, "Remainder", "Returns the remainder of x / y (Using round to nearest)");
+  addFunction(Function_Mod<T>, "math.mod", 2u, 2u, "Modulo", "Returns modulo of x / y");
+  addFunction(Function_Pow<T>, "math.pow", 2u, 2u, "Power", "Returns x to the power of y");
+  addFunction(Function_Sqr<T>, "math.sqr", 1u, 1u, "Square", "Returns x to the power of 2");
+  addFunction(Function_Cb<T>, "math.cb", 1u, 1u, "Cube", "Returns x to the power of 3");
+  addFunction(Function_Root<T>, "math.root", 2u, 2u, "Root", "Returns nth root of x");
+  addFunction(Traits::Function_Sqrt, "math.sqrt", 1u, 1u, "Square root", "Returns square root of x");
+  addFunction(Function_Cbrt<T>, "math.cbrt", 1u, 1u, "Cubic root", "Returns cubic root of x");
+  context.functionInfoMap.push_back(std::make_tuple(nullptr, "", ""));
+
+  addFunction(Traits::Function_Binom, "binom", 2u, 2u, "Binomial coefficient", "Returns x choose y (Extended to non-integers by the gamma function)");
+  addFunction(Traits::Function_Multinom,
+              "multinom",
+              1u,
+              FunctionToken::GetArgumentCountMaxLimit(),
+              "Multinomial coefficient",
+              "Returns the number of ways to split the sum of the arguments into groups of the specified sizes");
+  context.functionInfoMap.push_back(std::make_tuple(nullptr, "", ""));
+
+  addFunction(Function_Exp<T>, "math.exp", 1u, 1u, "Natural exponent", "Returns e to the power of x");
+  addFunction(Function_Exp2<T>, "math.exp2", 1u, 1u, "Binary exponent", "Returns 2 to the power of x");
+  addFunction(Function_Exp10<T>, "math.exp10", 1u, 1u, "Decimal exponent", "Returns 10 to the power of x");
+  addFunction(Function_LogN<T>, "math.logn", 1u, 1u, "Logarithm", "Returns nth logarithm of x");
+  addFunction(Function_Log<T>, "math.log", 1u, 1u, "Natural logarithm", "Returns nth logarithm of e");
+  addFunction(Function_Log2<T>, "math.log2", 1u, 1u, "Binary logarithm", "Returns nth logarithm of 2");
+  addFunction(Function_Log10<T>, "math.log10", 1u, 1u, "Decimal logarithm", "Returns nth logarithm of 10");
+  context.functionInfoMap.push_back(std::make_tuple(nullptr, "", ""));
+
+  addFunction(Function_Sin<T>, "math.sin", 1u, 1u, "Sine", "Trigonometric function");
+  addFunction(Function_Cos<T>, "math.cos", 1u, 1u, "Cosine", "Trigonometric function");
+  addFunction(Function_Tan<T>, "math.tan", 1u, 1u, "tangent", "Trigonometric function");
+  addFunction(Function_Cot<T>, "math.cot", 1u, 1u, "cotangent", "Trigonometric function");
+  addFunction(Function_Sec<T>, "math.sec", 1u, 1u, "secant", "Trigonometric function");
+  addFunction(Function_Csc<T>, "math.csc", 1u, 1u, "cosecant", "Trigonometric function");
+
+  addFunction(Function_ASin<T>, "math.asin", 1u, 1u, "Arcsine", "Trigonometric function");
+  addFunction(Function_ACos<T>, "math.acos", 1u, 1u, "Arccosine", "Trigonometric function");
+  addFunction(Function_ATan<T>, "math.atan", 1u, 1u, "Arctangent", "Trigonometric function");
+  addFunction(Function_ATan2<T>, "math.atan2", 2u, 2u, "Arctangent 2", "Trigonometric function (2 argument version)");
+  addFunction(Function_ACot<T>, "math.acot", 1u, 1u, "Arccotangent", "Trigonometric function");
+  addFunction(Function_ASec<T>, "math.asec", 1u, 1u, "Arcsecant", "Trigonometric function");
+  addFunction(Function_ACsc<T>, "math.acsc", 1u, 1u, "Arccosecant", "Trigonometric function");
+
+  addFunction(Function_SinH<T>, "math.sinh", 1u, 1u, "Hyperbolic sine", "Trigonometric function");
+  addFunction(Function_CosH<T>, "math.cosh", 1u, 1u, "Hyperbolic cosine", "Trigonometric function");
+  addFunction(Function_TanH<T>, "math.tanh", 1u, 1u, "Hyperbolic tangent", "Trigonometric function");
+  addFunction(Function_CotH<T>, "math.coth", 1u, 1u, "Hyperbolic cotangent", "Trigonometric function");
+  addFunction(Function_SecH<T>, "math.sech", 1u, 1u, "Hyperbolic secant", "Trigonometric function");
+  addFunction(Function_CscH<T>, "math.csch", 1u, 1u, "Hyperbolic cosecant", "Trigonometric function");
+
+  addFunction(Function_ASinH<T>, "math.asinh", 1u, 1u, "Hyperbolic arcsine", "Trigonometric function");
+  addFunction(Function_ACosH<T>, "math.acosh", 1u, 1u, "Hyperbolic arccosine", "Trigonometric function");
+  addFunction(Function_ATanH<T>, "math.atanh", 1u, 1u, "Hyperbolic arctangent", "Trigonometric function");
+  addFunction(Function_ACotH<T>, "math.acoth", 1u, 1u, "Hyperbolic arccotangent", "Trigonometric function");
+  addFunction(Function_ASecH<T>, "math.asech", 1u, 1u, "Hyperbolic arcsecant", "Trigonometric function");
+  addFunction(Function_ACscH<T>, "math.acsch", 1u, 1u, "Hyperbolic arccosecant", "Trigonometric function");
+  context.functionInfoMap.push_back(std::make_tuple(nullptr, "", ""));
+
+  addFunction(Function_Min<T>, "min", 1u, FunctionToken::GetArgumentCountMaxLimit(), "Min", "Returns the minimum of specified arguments");
+  addFunction(Function_Max<T>, "max", 1u, FunctionToken::GetArgumentCountMaxLimit(), "Max", "Returns the maximum of specified arguments");
+
+  addFunction(Function_Mean<T>, "math.mean", 1u, FunctionToken::GetArgumentCountMaxLimit(), "Mean", "Returns the mean of specified arguments");
+  addFunction(Function_Median<T>, "math.median", 1u, FunctionToken::GetArgumentCountMaxLimit(), "Median", "Returns the median of specified arguments");
+  addFunction(Function_Mode<T>, "math.mode", 1u, FunctionToken::GetArgumentCountMaxLimit(), "Mode", "Returns the mode of specified arguments");
+  addFunction(Function_Quartile_Lower<T>,
+              "math.q1",
+              1u,
+              FunctionToken::GetArgumentCountMaxLimit(),
+              "First quartile",
+              "Returns the first quartile of specified arguments");
+  addFunction(Function_Median<T>,
+              "math.q2",
+              1u,
+              FunctionToken::GetArgumentCountMaxLimit(),
+              "Second quartile",
+              "Returns the second quartile of specified arguments");
+  addFunction(Function_Quartile_Upper<T>,
+              "math.q3",
+              1u,
+              FunctionToken::GetArgumentCountMaxLimit(),
+              "Third quartile",
+              "Returns the third quartile of specified arguments");
+  addFunction(Function_StdDev<T>,
+              "math.stddev",
+              1u,
+              FunctionToken::GetArgumentCountMaxLimit(),
+              "Standard deviation",
+              "Returns the standard deviation of specified arguments");
+  context.functionInfoMap.push_back(std::make_tuple(nullptr, "", ""));
+
+  addFunction(Function_Vec<T>, "vec", 1u, FunctionToken::GetArgumentCountMaxLimit(), "Vector", "Returns a vector of the specified arguments");
+  addFunction(Function_VecRange<T>, "vec.range", 1u, 3u, "Range", "Returns a vector from x (default 0) up to but excluding y in steps of z (default 1)");
+  addFunction(Function_VecLen<T>, "vec.len", 1u, 1u, "Vector length", "Returns the number of elements of a vector");
+  context.functionInfoMap.push_back(std::make_tuple(nullptr, "", ""));
+}
+
+template<class T>
+void addStringFunctions()
+{
+  addFunction(Function_Str<T>, "str", 1u, 1u, "Stringify", "Returns string representation of argument");
+  addFunction(Function_StrLen<T>, "strlen", 1u, 1u, "String length", "Returns length of string argument");
+  currentContext().functionInfoMap.push_back(std::make_tuple(nullptr, "", ""));
+}
+
+// Metric, binary and parts-per prefixes of both engines, in listing order.
+template<class T>
+void addNumericPrefixes()
+{
+  using Traits  = NumericTraits<T>;
+  auto& context = currentContext();
+
+  Traits::AddConstant(powerOfTen<T, 30>, "Q", "Quetta", "Metric prefix (10^30)");
+  Traits::AddConstant(powerOfTen<T, 27>, "R", "Ronna", "Metric prefix (10^27)");
+  Traits::AddConstant(powerOfTen<T, 24>, "Y", "Yotta", "Metric prefix (10^24)");
+  Traits::AddConstant(powerOfTen<T, 21>, "Z", "Zetta", "Metric prefix (10^21)");
+  Traits::AddConstant(powerOfTen<T, 18>, "E", "Exa", "Metric prefix (10^18)");
+  Traits::AddConstant(powerOfTen<T, 15>, "P", "Peta", "Metric prefix (10^15)");
+  Traits::AddConstant(powerOfTen<T, 12>, "T", "Tera", "Metric prefix (10^12)");
+  Traits::AddConstant(powerOfTen<T, 9>, "G", "Giga", "Metric prefix (10^9)");
+  Traits::AddConstant(powerOfTen<T, 6>, "M", "Mega", "Metric prefix (10^6)");
+  Traits::AddConstant(powerOfTen<T, 3>, "k", "Kilo", "Metric prefix (10^3)");
+  Traits::AddConstant(powerOfTen<T, 2>, "h", "Hecto", "Metric prefix (10^2)");
+  Traits::AddConstant(powerOfTen<T, 1>, "da", "Deca", "Metric prefix (10^1)");
+  Traits::AddConstant(powerOfTen<T, -1>, "d", "Deci", "Metric prefix (10^-1)");
+  Traits::AddConstant(powerOfTen<T, -2>, "c", "Centi", "Metric prefix (10^-2)");
+  Traits::AddConstant(powerOfTen<T, -3>, "m", "Milli", "Metric prefix (10^-3)");
+  Traits::AddConstant(powerOfTen<T, -6>, "u", "Micro", "Metric prefix (10^-6)");
+  Traits::AddConstant(powerOfTen<T, -9>, "n", "Nano", "Metric prefix (10^-9)");
+  Traits::AddConstant(powerOfTen<T, -12>, "p", "Pico", "Metric prefix (10^-12)");
+  Traits::AddConstant(powerOfTen<T, -15>, "f", "Femto", "Metric prefix (10^-15)");
+  Traits::AddConstant(powerOfTen<T, -18>, "a", "Atto", "Metric prefix (10^-18)");
+  Traits::AddConstant(powerOfTen<T, -21>, "z", "Zepto", "Metric prefix (10^-21)");
+  Traits::AddConstant(powerOfTen<T, -24>, "y", "Yocto", "Metric prefix (10^-24)");
+  Traits::AddConstant(powerOfTen<T, -27>, "r", "Ronto", "Metric prefix (10^-27)");
+  Traits::AddConstant(powerOfTen<T, -30>, "q", "Quekto", "Metric prefix (10^-30)");
+  context.variableInfoMap.push_back(std::make_tuple("", "", ""));
+
+  Traits::AddConstant(powerOfTwo<T, 10>, "Ki", "Kibi", "Binary prefix (2^10)");
+  Traits::AddConstant(powerOfTwo<T, 20>, "Mi", "Mebi", "Binary prefix (2^20)");
+  Traits::AddConstant(powerOfTwo<T, 30>, "Gi", "Gibi", "Binary prefix (2^30)");
+  Traits::AddConstant(powerOfTwo<T, 40>, "Ti", "Tebi", "Binary prefix (2^40)");
+  Traits::AddConstant(powerOfTwo<T, 50>, "Pi", "Pebi", "Binary prefix (2^50)");
+  Traits::AddConstant(powerOfTwo<T, 60>, "Ei", "Exbi", "Binary prefix (2^60)");
+  Traits::AddConstant(powerOfTwo<T, 70>, "Zi", "Zebi", "Binary prefix (2^70)");
+  Traits::AddConstant(powerOfTwo<T, 80>, "Yi", "Yobi", "Binary prefix (2^80)");
+  context.variableInfoMap.push_back(std::make_tuple("", "", ""));
+
+  Traits::AddConstant(powerOfTen<T, -2>, "pc", "Percent", "Parts-per notation (10^-2)");
+  Traits::AddConstant(powerOfTen<T, -3>, "pm", "Permille", "Parts-per notation (10^-3)");
+  Traits::AddConstant(powerOfTen<T, -4>, "ptt", "Parts per ten thousand", "Parts-per notation (10^-4)");
+  Traits::AddConstant(powerOfTen<T, -6>, "ppm", "Parts per million", "Parts-per notation (10^-6)");
+  Traits::AddConstant(powerOfTen<T, -9>, "ppb", "Parts per billion", "Parts-per notation (10^-9)");
+  Traits::AddConstant(powerOfTen<T, -12>, "ppt", "Parts per trillion", "Parts-per notation (10^-12)");
+  Traits::AddConstant(powerOfTen<T, -15>, "ppq", "Parts per quadrillion", "Parts-per notation (10^-15)");
+  context.variableInfoMap.push_back(std::make_tuple("", "", ""));
+}
+
+#endif // __NUMERICSETUP_HPP__
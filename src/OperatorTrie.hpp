@@ -0,0 +1,92 @@
+#ifndef __OPERATORTRIE_HPP__
+#define __OPERATORTRIE_HPP__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Prefix tree over operator symbols. Match() walks the input once and reports the longest operator it starts with, e.g. "**" rather than "*".
+template<class TValue>
+class OperatorTrie
+{
+  public:
+  OperatorTrie() { Clear(); }
+
+  void Clear()
+  {
+    m_Nodes.assign(1u, Node());
+    m_Values.clear();
+  }
+
+  void Insert(std::string_view key, const TValue& value)
+  {
+    std::size_t node = 0u;
+    for(const char i : key)
+    {
+      const auto symbol = static_cast<unsigned char>(i);
+      if(symbol >= kAlphabetSize)
+      {
+        return;
+      }
+
+      if(m_Nodes[node].children[symbol] == 0u)
+      {
+        m_Nodes[node].children[symbol] = static_cast<std::uint32_t>(m_Nodes.size());
+        m_Nodes.emplace_back();
+      }
+
+      node = m_Nodes[node].children[symbol];
+    }
+
+    if(m_Nodes[node].value == kNoValue)
+    {
+      m_Nodes[node].value = static_cast<std::uint32_t>(m_Values.size());
+      m_Values.push_back(value);
+    }
+    else
+    {
+      m_Values[m_Nodes[node].value] = value;
+    }
+  }
+
+  std::pair<const TValue*, std::size_t> Match(std::string_view input) const
+  {
+    std::pair<const TValue*, std::size_t> result(nullptr, 0u);
+    std::size_t node = 0u;
+    for(std::size_t i = 0u; i < input.length(); i++)
+    {
+      const auto symbol = static_cast<unsigned char>(input[i]);
+      if(symbol >= kAlphabetSize || m_Nodes[node].children[symbol] == 0u)
+      {
+        break;
+      }
+
+      node = m_Nodes[node].children[symbol];
+      if(m_Nodes[node].value != kNoValue)
+      {
+        result = std::make_pair(&m_Values[m_Nodes[node].value], i + 1u);
+      }
+    }
+
+    return result;
+  }
+
+  private:
+  static constexpr std::size_t kAlphabetSize = 128u;
+  static constexpr std::uint32_t kNoValue    = std::numeric_limits<std::uint32_t>::max();
+
+  struct Node
+  {
+    std::array<std::uint32_t, kAlphabetSize> children {};
+    std::uint32_t value = kNoValue;
+  };
+
+  std::vector<Node> m_Nodes;
+  std::vector<TValue> m_Values;
+};
+
+#endif // __OPERATORTRIE_HPP__
@@ -0,0 +1,190 @@
+#ifndef __PERFECTHASHMAP_HPP__
+#define __PERFECTHASHMAP_HPP__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Read-only map over a fixed key set, built with hash and displace (CHD). Keys are grouped into small buckets by their hash, and Build() picks a
+// displacement per bucket, largest bucket first, that moves all of its keys into free slots. A lookup is one key hash, one displacement read, one mix
+// and one key comparison.
+template<class TValue>
+class PerfectHashMap
+{
+  public:
+  using EntryType = std::pair<std::string, TValue>;
+
+  std::size_t GetSize() const { return m_Size; }
+  std::size_t GetSlotCount() const { return m_Slots.size(); }
+
+  void Build(const std::vector<EntryType>& entries)
+  {
+    m_Slots.clear();
+    m_Displacements.clear();
+    m_Size = entries.size();
+    m_Seed = 0u;
+    if(entries.empty())
+    {
+      return;
+    }
+
+    // Slots are kept at most 80 % full, and buckets hold four keys on average.
+    std::size_t slotCount = powerOfTwoAtLeast(entries.size() + entries.size() / 4u);
+    for(;; slotCount <<= 1u)
+    {
+      for(std::uint64_t seed = 0u; seed < kMaxSeedAttempts; seed++)
+      {
+        if(TryBuild(entries, slotCount, powerOfTwoAtLeast((entries.size() + 3u) / 4u), seed))
+        {
+          return;
+        }
+      }
+    }
+  }
+
+  const TValue* Find(std::string_view key) const
+  {
+    if(m_Slots.empty())
+    {
+      return nullptr;
+    }
+
+    const auto hash  = Hash(key, m_Seed);
+    const auto& slot = m_Slots[SlotOf(hash, m_Displacements[hash & (m_Displacements.size() - 1u)], m_Slots.size())];
+    return (slot.occupied && slot.key == key) ? &slot.value : nullptr;
+  }
+
+  private:
+  static constexpr std::uint64_t kMaxSeedAttempts = 16u;
+  static constexpr std::uint32_t kMaxDisplacement = 1u << 16u;
+
+  struct Slot
+  {
+    std::string key;
+    TValue value {};
+    bool occupied = false;
+  };
+
+  static std::size_t powerOfTwoAtLeast(std::size_t value)
+  {
+    std::size_t result = 1u;
+    while(result < value)
+    {
+      result <<= 1u;
+    }
+
+    return result;
+  }
+
+  // SplitMix64 finalizer.
+  static std::uint64_t Mix(std::uint64_t value)
+  {
+    value ^= value >> 30u;
+    value *= 0xBF58476D1CE4E5B9ull;
+    value ^= value >> 27u;
+    value *= 0x94D049BB133111EBull;
+    return value ^ (value >> 31u);
+  }
+
+  static std::uint64_t Hash(std::string_view key, std::uint64_t seed)
+  {
+    std::uint64_t result = 14695981039346656037ull ^ (seed * 0x9E3779B97F4A7C15ull);
+    for(const char i : key)
+    {
+      result ^= static_cast<unsigned char>(i);
+      result *= 1099511628211ull;
+    }
+
+    return Mix(result);
+  }
+
+  static std::size_t SlotOf(std::uint64_t hash, std::uint32_t displacement, std::size_t slotCount)
+  {
+    return static_cast<std::size_t>(Mix(hash + (displacement + 1u) * 0x9E3779B97F4A7C15ull)) & (slotCount - 1u);
+  }
+
+  // Searches the displacements on key hashes alone. Keys and values are copied into the slots only once every bucket has found one.
+  bool TryBuild(const std::vector<EntryType>& entries, std::size_t slotCount, std::size_t bucketCount, std::uint64_t seed)
+  {
+    std::vector<std::uint64_t> hashes(entries.size());
+    std::vector<std::vector<std::size_t>> buckets(bucketCount);
+    for(std::size_t i = 0u; i < entries.size(); i++)
+    {
+      hashes[i] = Hash(entries[i].first, seed);
+      buckets[hashes[i] & (bucketCount - 1u)].push_back(i);
+    }
+
+    std::vector<std::size_t> order(bucketCount);
+    for(std::size_t i = 0u; i < bucketCount; i++)
+    {
+      order[i] = i;
+    }
+
+    std::stable_sort(order.begin(), order.end(), [&buckets](std::size_t a, std::size_t b) { return buckets[a].size() > buckets[b].size(); });
+
+    std::vector<std::uint32_t> displacements(bucketCount, 0u);
+    std::vector<bool> taken(slotCount, false);
+    std::vector<std::size_t> placed;
+    for(const auto bucket : order)
+    {
+      if(buckets[bucket].empty())
+      {
+        break;
+      }
+
+      bool found = false;
+      for(std::uint32_t displacement = 0u; !found && displacement < kMaxDisplacement; displacement++)
+      {
+        placed.clear();
+        found = true;
+        for(const auto i : buckets[bucket])
+        {
+          const auto slot = SlotOf(hashes[i], displacement, slotCount);
+          if(taken[slot] || std::find(placed.cbegin(), placed.cend(), slot) != placed.cend())
+          {
+            found = false;
+            break;
+          }
+
+          placed.push_back(slot);
+        }
+
+        if(found)
+        {
+          displacements[bucket] = displacement;
+        }
+      }
+
+      if(!found)
+      {
+        return false;
+      }
+
+      for(const auto slot : placed)
+      {
+        taken[slot] = true;
+      }
+    }
+
+    m_Slots.assign(slotCount, Slot());
+    for(std::size_t i = 0u; i < entries.size(); i++)
+    {
+      m_Slots[SlotOf(hashes[i], displacements[hashes[i] & (bucketCount - 1u)], slotCount)] = {entries[i].first, entries[i].second, true};
+    }
+
+    m_Displacements = std::move(displacements);
+    m_Seed          = seed;
+    return true;
+  }
+
+  std::vector<Slot> m_Slots;
+  std::vector<std::uint32_t> m_Displacements;
+  std::size_t m_Size   = 0u;
+  std::uint64_t m_Seed = 0u;
+};
+
+#endif // __PERFECTHASHMAP_HPP__
@@ -0,0 +1,269 @@
+#include "RadixWriter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+// Digits converted by a single mpz_get_str call at the bottom of the recursion.
+static constexpr std::size_t kLeafDigits = 1u << 10u;
+
+class DigitWriter
+{
+  public:
+  static constexpr std::size_t kNoPoint = std::numeric_limits<std::size_t>::max();
+
+  // A decimal point is written after pointPosition digits, provided more digits follow.
+  DigitWriter(std::ostream& stream, int base, std::size_t pointPosition = kNoPoint)
+      : m_Stream(stream)
+      , m_Base(base)
+      , m_PointPosition(pointPosition)
+  {}
+
+  // Digits of a non-negative value, without leading zeros.
+  void Write(const mpz_class& value)
+  {
+    m_Powers.clear();
+    m_Powers.emplace_back();
+    mpz_ui_pow_ui(m_Powers.back().get_mpz_t(), static_cast<unsigned long>(m_Base), kLeafDigits);
+
+    std::size_t level = 0u;
+    if(value >= m_Powers.front())
+    {
+      const auto bits = mpz_sizeinbase(value.get_mpz_t(), 2);
+      while(bits > 2u * (mpz_sizeinbase(m_Powers.back().get_mpz_t(), 2) - 1u))
+      {
+        m_Powers.push_back(m_Powers.back() * m_Powers.back());
+      }
+
+      level = m_Powers.size();
+    }
+
+    Write(value, level, false);
+    m_Powers.clear();
+  }
+
+  void WriteZeros(std::size_t count)
+  {
+    static const std::string kZeros(64u, '0');
+    while(count > 0u)
+    {
+      const auto length = std::min(count, kZeros.length());
+      Emit(kZeros.data(), length);
+      count -= length;
+    }
+  }
+
+  private:
+  // value is below base^(kLeafDigits * 2^level). When padded, exactly that many digits are written.
+  void Write(const mpz_class& value, std::size_t level, bool pad)
+  {
+    if(level == 0u)
+    {
+      char buffer[kLeafDigits + 2u];
+      mpz_get_str(buffer, m_Base, value.get_mpz_t());
+      const auto length = std::strlen(buffer);
+      if(pad)
+      {
+        WriteZeros(kLeafDigits - length);
+      }
+
+      Emit(buffer, length);
+      return;
+    }
+
+    const auto& divisor = m_Powers[level - 1u];
+    if(!pad && value < divisor)
+    {
+      Write(value, level - 1u, false);
+      return;
+    }
+
+    mpz_class quotient;
+    mpz_class remainder;
+    mpz_tdiv_qr(quotient.get_mpz_t(), remainder.get_mpz_t(), value.get_mpz_t(), divisor.get_mpz_t());
+    Write(quotient, level - 1u, pad);
+    quotient = 0;
+    Write(remainder, level - 1u, true);
+  }
+
+  void Emit(const char* digits, std::size_t count)
+  {
+    if(m_Count < m_PointPosition && m_Count + count > m_PointPosition)
+    {
+      const auto head = m_PointPosition - m_Count;
+      m_Stream.write(digits, static_cast<std::streamsize>(head));
+      m_Stream.put('.');
+      m_Stream.write(digits + head, static_cast<std::streamsize>(count - head));
+    }
+    else
+    {
+      m_Stream.write(digits, static_cast<std::streamsize>(count));
+    }
+
+    m_Count += count;
+  }
+
+  std::ostream& m_Stream;
+  int m_Base;
+  std::size_t m_PointPosition;
+  std::size_t m_Count = 0u;
+  std::vector<mpz_class> m_Powers;
+};
+
+static void checkBase(int base)
+{
+  if(base < 2 || base > 62)
+  {
+    throw std::domain_error("Output base out of range: " + std::to_string(base));
+  }
+}
+
+static mpz_class power(int base, unsigned long exponent)
+{
+  mpz_class result;
+  mpz_ui_pow_ui(result.get_mpz_t(), static_cast<unsigned long>(base), exponent);
+  return result;
+}
+
+// mantissa * 2^binaryExponent * base^exponent rounded to the nearest integer, ties to even. Only a power of two divisor is left when exponent is non-negative,
+// which is the common case of printing more digits than the integer part has, and that division is a shift.
+static mpz_class scale(const mpz_class& mantissa, long binaryExponent, int base, long exponent)
+{
+  mpz_class numerator = mantissa;
+  if(exponent >= 0)
+  {
+    numerator *= power(base, static_cast<unsigned long>(exponent));
+  }
+
+  if(binaryExponent >= 0)
+  {
+    numerator <<= static_cast<mp_bitcnt_t>(binaryExponent);
+  }
+
+  mpz_class result;
+  bool roundUp;
+  if(exponent >= 0 && binaryExponent >= 0)
+  {
+    return numerator;
+  }
+  else if(exponent >= 0)
+  {
+    const auto shift = static_cast<mp_bitcnt_t>(-binaryExponent);
+    mpz_fdiv_q_2exp(result.get_mpz_t(), numerator.get_mpz_t(), shift);
+    roundUp = mpz_tstbit(numerator.get_mpz_t(), shift - 1u) != 0 && (mpz_scan1(numerator.get_mpz_t(), 0u) < shift - 1u || mpz_odd_p(result.get_mpz_t()));
+  }
+  else
+  {
+    auto denominator = power(base, static_cast<unsigned long>(-exponent));
+    if(binaryExponent < 0)
+    {
+      denominator <<= static_cast<mp_bitcnt_t>(-binaryExponent);
+    }
+
+    mpz_class remainder;
+    mpz_fdiv_qr(result.get_mpz_t(), remainder.get_mpz_t(), numerator.get_mpz_t(), denominator.get_mpz_t());
+    const int comparison = cmp(remainder * 2, denominator);
+    roundUp = comparison > 0 || (comparison == 0 && mpz_odd_p(result.get_mpz_t()));
+  }
+
+  if(roundUp)
+  {
+    result += 1;
+  }
+
+  return result;
+}
+
+// Writes the positive value mantissa * 2^binaryExponent.
+static void writeScaled(std::ostream& stream, const mpz_class& mantissa, long binaryExponent, int digits, int base)
+{
+  const auto magnitude = binaryExponent + static_cast<long>(mpz_sizeinbase(mantissa.get_mpz_t(), 2));
+  long exponent        = static_cast<long>(std::floor(static_cast<double>(magnitude - 1) * std::log(2.0) / std::log(static_cast<double>(base))));
+
+  const auto lower = power(base, static_cast<unsigned long>(digits - 1));
+  const auto upper = lower * base;
+  mpz_class significand;
+  while(true)
+  {
+    significand = scale(mantissa, binaryExponent, base, digits - 1 - exponent);
+    if(significand < lower)
+    {
+      exponent--;
+    }
+    else if(significand >= upper)
+    {
+      exponent++;
+    }
+    else
+    {
+      break;
+    }
+  }
+
+  const mpz_class divisor(base);
+  const auto trailingZeros = static_cast<long>(mpz_remove(significand.get_mpz_t(), significand.get_mpz_t(), divisor.get_mpz_t()));
+  const auto length        = digits - trailingZeros;
+  if(exponent < -4 || exponent >= digits)
+  {
+    DigitWriter(stream, base, 1u).Write(significand);
+    stream << (base == 10 ? 'e' : '@') << (exponent < 0 ? '-' : '+') << (base == 10 && std::abs(exponent) < 10 ? "0" : "") << std::abs(exponent);
+  }
+  else if(exponent >= 0)
+  {
+    DigitWriter writer(stream, base, static_cast<std::size_t>(exponent + 1));
+    writer.Write(significand);
+    writer.WriteZeros(static_cast<std::size_t>(std::max(exponent + 1 - length, 0l)));
+  }
+  else
+  {
+    stream << "0.";
+    DigitWriter writer(stream, base);
+    writer.WriteZeros(static_cast<std::size_t>(-exponent - 1));
+    writer.Write(significand);
+  }
+}
+
+void writeInteger(std::ostream& stream, const mpz_class& value, int base)
+{
+  checkBase(base);
+  if(sgn(value) < 0)
+  {
+    stream.put('-');
+  }
+
+  DigitWriter(stream, base).Write(abs(value));
+}
+
+void writeFloat(std::ostream& stream, const mpfr::mpreal& value, int digits, int base)
+{
+  checkBase(base);
+  const auto source = value.mpfr_srcptr();
+  if(mpfr_nan_p(source) != 0)
+  {
+    stream << "nan";
+    return;
+  }
+
+  if(mpfr_signbit(source) != 0)
+  {
+    stream.put('-');
+  }
+
+  if(mpfr_inf_p(source) != 0)
+  {
+    stream << "inf";
+  }
+  else if(mpfr_zero_p(source) != 0)
+  {
+    stream.put('0');
+  }
+  else
+  {
+    mpz_class mantissa;
+    const auto binaryExponent = mpfr_get_z_2exp(mantissa.get_mpz_t(), source);
+    writeScaled(stream, abs(mantissa), static_cast<long>(binaryExponent), std::max(digits, 1), base);
+  }
+}
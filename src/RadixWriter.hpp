@@ -0,0 +1,19 @@
+#ifndef __RADIXWRITER_HPP__
+#define __RADIXWRITER_HPP__
+
+#include <ostream>
+
+#include <gmpxx.h>
+#include <mpreal.h>
+
+// Digit count from which printed numbers are streamed with the functions below rather than formatted into a string first.
+constexpr int kStreamingDigits = 1 << 12;
+
+// Both functions convert by divide and conquer, splitting on squared powers of the base. Digits are written as each piece is converted, so memory stays
+// proportional to the binary size of the number rather than to its digit string. Any base from 2 to 62 is accepted.
+void writeInteger(std::ostream& stream, const mpz_class& value, int base);
+// Formats like printf("%.*g") with the specified number of significant digits, rounding to nearest. The exponent is introduced by 'e' in base 10 and by
+// '@' otherwise, where it counts powers of the base (written in decimal).
+void writeFloat(std::ostream& stream, const mpfr::mpreal& value, int digits, int base);
+
+#endif // __RADIXWRITER_HPP__
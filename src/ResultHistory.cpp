@@ -0,0 +1,269 @@
+#include "ResultHistory.hpp"
+#include "KalkContext.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+
+#include <boost/format.hpp>
+
+template<class T>
+static std::string encode(const T& value);
+
+template<>
+std::string encode(const std::nullptr_t&) { return std::string(); }
+
+template<>
+std::string encode(const DefaultArithmeticType& value) { return std::to_string(mpfr_get_prec(value.mpfr_srcptr())) + ' ' + value.toString("%Ra"); }
+
+template<>
+std::string encode(const DefaultIntegerType& value) { return value.get_str(16); }
+
+template<>
+std::string encode(const std::string& value) { return value; }
+
+template<>
+std::string encode(const boost::posix_time::ptime& value) { return boost::posix_time::to_iso_string(value); }
+
+template<>
+std::string encode(const boost::posix_time::time_duration& value) { return boost::posix_time::to_simple_string(value); }
+
+template<>
+std::string encode(const DefaultVectorType& value)
+{
+  std::string result;
+  for(std::size_t i = 0u; i < value.GetSize(); i++)
+  {
+    if(i > 0u)
+    {
+      result += '\n';
+    }
+
+    result += encode(value[i]);
+  }
+
+  return result;
+}
+
+template<class T>
+static DefaultValueType decode(const std::string& payload);
+
+template<>
+DefaultValueType decode<std::nullptr_t>(const std::string&) { return DefaultValueType(nullptr); }
+
+template<>
+DefaultValueType decode<DefaultArithmeticType>(const std::string& payload)
+{
+  const auto separator = payload.find(' ');
+  return DefaultValueType(DefaultArithmeticType(payload.substr(separator + 1u),
+                                                static_cast<mpfr_prec_t>(std::stol(payload.substr(0u, separator))),
+                                                0,
+                                                mpfr::mpreal::get_default_rnd()));
+}
+
+template<>
+DefaultValueType decode<DefaultIntegerType>(const std::string& payload) { return DefaultValueType(DefaultIntegerType(payload, 16)); }
+
+template<>
+DefaultValueType decode<std::string>(const std::string& payload) { return DefaultValueType(payload); }
+
+template<>
+DefaultValueType decode<boost::posix_time::ptime>(const std::string& payload) { return DefaultValueType(boost::posix_time::from_iso_string(payload)); }
+
+template<>
+DefaultValueType decode<boost::posix_time::time_duration>(const std::string& payload)
+{
+  return DefaultValueType(boost::posix_time::duration_from_string(payload));
+}
+
+template<>
+DefaultValueType decode<DefaultVectorType>(const std::string& payload)
+{
+  DefaultVectorType result;
+  for(std::size_t begin = 0u; begin < payload.length();)
+  {
+    auto end = payload.find('\n', begin);
+    if(end == std::string::npos)
+    {
+      end = payload.length();
+    }
+
+    result.GetElements().push_back(decode<DefaultArithmeticType>(payload.substr(begin, end - begin)).GetValue<DefaultArithmeticType>());
+    begin = end + 1u;
+  }
+
+  return DefaultValueType(result);
+}
+
+struct Encoder
+{
+  using ResultType = std::string;
+
+  template<class T>
+  static constexpr bool Supports = true;
+
+  template<class T>
+  static std::string Apply(const T& value) { return encode(value); }
+};
+
+template<class... Ts>
+static DefaultValueType decodeValue(std::size_t tag, const std::string& payload, TypeList<Ts...>)
+{
+  static constexpr DefaultValueType (*decoders[])(const std::string&) = {&decode<Ts>...};
+  if(tag >= sizeof...(Ts))
+  {
+    throw std::runtime_error("Corrupt history file entry");
+  }
+
+  return decoders[tag](payload);
+}
+
+ResultHistory::ResultHistory(std::size_t capacity)
+    : m_Capacity(capacity)
+    , m_Paged(nullptr)
+{}
+
+void ResultHistory::SetCapacity(std::size_t value)
+{
+  Linearize();
+  if(value != 0u && m_Entries.size() > value)
+  {
+    const auto evictCount = m_Entries.size() - value;
+    for(std::size_t i = 0u; i < evictCount; i++)
+    {
+      Evict(m_Entries[i]);
+    }
+
+    m_Entries.erase(m_Entries.begin(), std::next(m_Entries.begin(), static_cast<std::ptrdiff_t>(evictCount)));
+  }
+
+  m_Capacity = value;
+}
+
+void ResultHistory::SetSpillPath(const std::string& value)
+{
+  if(m_SpillFile.is_open())
+  {
+    m_SpillFile.close();
+  }
+
+  m_Dropped += m_SpillOffsets.size();
+  m_SpillOffsets.clear();
+  m_SpillPath = value;
+
+  if(!m_SpillPath.empty())
+  {
+    m_SpillFile.open(m_SpillPath, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!m_SpillFile.is_open())
+    {
+      m_SpillPath.clear();
+      throw std::runtime_error("Could not open history file: " + value);
+    }
+  }
+}
+
+void ResultHistory::Push(const DefaultValueType& value)
+{
+  if(m_Capacity == 0u || m_Entries.size() < m_Capacity)
+  {
+    m_Entries.push_back(value);
+    m_Size++;
+    return;
+  }
+
+  Evict(m_Entries[m_Head]);
+  m_Entries[m_Head] = value;
+  m_Head            = (m_Head + 1u) % m_Entries.size();
+  m_Size++;
+}
+
+const DefaultValueType* ResultHistory::Get(std::size_t index) const
+{
+  if(index >= m_Size || index < m_Dropped)
+  {
+    return nullptr;
+  }
+
+  const auto firstRetained = m_Size - m_Entries.size();
+  if(index >= firstRetained)
+  {
+    return &m_Entries[(m_Head + (index - firstRetained)) % m_Entries.size()];
+  }
+
+  std::uint32_t length;
+  char tag;
+  m_SpillFile.seekg(static_cast<std::streamoff>(m_SpillOffsets[index - m_Dropped]));
+  m_SpillFile.read(&tag, sizeof(tag));
+  m_SpillFile.read(reinterpret_cast<char*>(&length), sizeof(length));
+
+  std::string payload(length, '\0');
+  m_SpillFile.read(payload.data(), static_cast<std::streamsize>(length));
+  if(!m_SpillFile)
+  {
+    m_SpillFile.clear();
+    throw std::runtime_error("Could not read history file: " + m_SpillPath);
+  }
+
+  m_Paged = decodeValue(static_cast<std::size_t>(tag), payload, DefaultTypeList());
+  return &m_Paged;
+}
+
+void ResultHistory::Clear()
+{
+  m_Entries.clear();
+  m_SpillOffsets.clear();
+  m_Head    = 0u;
+  m_Size    = 0u;
+  m_Dropped = 0u;
+
+  if(m_SpillFile.is_open())
+  {
+    m_SpillFile.close();
+    m_SpillFile.open(m_SpillPath, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+  }
+}
+
+void ResultHistory::Linearize()
+{
+  std::rotate(m_Entries.begin(), std::next(m_Entries.begin(), static_cast<std::ptrdiff_t>(m_Head)), m_Entries.end());
+  m_Head = 0u;
+}
+
+void ResultHistory::Evict(const DefaultValueType& value)
+{
+  if(!m_SpillFile.is_open())
+  {
+    m_Dropped++;
+    return;
+  }
+
+  const auto payload = UnaryDispatchTable<Encoder, DefaultValueType, DefaultTypeList>::Find(value)(value);
+  const auto tag     = static_cast<char>(DefaultTypeList::IndexOf(value.GetType()));
+  const auto length  = static_cast<std::uint32_t>(payload.size());
+
+  m_SpillFile.seekp(0, std::ios::end);
+  const auto offset = static_cast<std::uint64_t>(m_SpillFile.tellp());
+  m_SpillFile.write(&tag, sizeof(tag));
+  m_SpillFile.write(reinterpret_cast<const char*>(&length), sizeof(length));
+  m_SpillFile.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+  if(!m_SpillFile)
+  {
+    m_SpillFile.clear();
+    throw std::runtime_error("Could not write history file: " + m_SpillPath);
+  }
+
+  m_SpillOffsets.push_back(offset);
+}
+
+void printHistoryStatistics()
+{
+  const auto& context = currentContext();
+  std::cerr << "Result history" << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Results" % context.results.GetSize()) << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|/%3%") % "Retained" % context.results.GetRetainedCount() % context.results.GetCapacity()) << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Spilled" % context.results.GetSpilledCount()) << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Dropped" % context.results.GetDroppedCount()) << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Spill file" % context.results.GetSpillPath()) << std::endl;
+  std::cerr << std::endl;
+}
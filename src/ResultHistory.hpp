@@ -0,0 +1,53 @@
+#ifndef __RESULTHISTORY_HPP__
+#define __RESULTHISTORY_HPP__
+
+#include "Setup.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+class ResultHistory
+{
+  public:
+  explicit ResultHistory(std::size_t capacity = 0u);
+
+  ResultHistory(const ResultHistory&)            = delete;
+  ResultHistory& operator=(const ResultHistory&) = delete;
+
+  std::size_t GetSize() const { return m_Size; }
+  std::size_t GetRetainedCount() const { return m_Entries.size(); }
+  std::size_t GetSpilledCount() const { return m_SpillOffsets.size(); }
+  std::size_t GetDroppedCount() const { return m_Dropped; }
+
+  std::size_t GetCapacity() const { return m_Capacity; }
+  void SetCapacity(std::size_t value);
+
+  const std::string& GetSpillPath() const { return m_SpillPath; }
+  void SetSpillPath(const std::string& value);
+
+  void Push(const DefaultValueType& value);
+  const DefaultValueType* Get(std::size_t index) const;
+  void Clear();
+
+  private:
+  void Linearize();
+  void Evict(const DefaultValueType& value);
+
+  std::size_t m_Capacity;
+  std::size_t m_Size    = 0u;
+  std::size_t m_Dropped = 0u;
+  std::size_t m_Head    = 0u;
+  std::vector<DefaultValueType> m_Entries;
+
+  std::string m_SpillPath;
+  mutable std::fstream m_SpillFile;
+  std::vector<std::uint64_t> m_SpillOffsets;
+  mutable DefaultValueType m_Paged;
+};
+
+void printHistoryStatistics();
+
+#endif // __RESULTHISTORY_HPP__
@@ -1,25 +1,54 @@
 #ifndef __SETUP_HPP__
 #define __SETUP_HPP__
 
+#include "TypeDispatch.hpp"
+#include "VectorValue.hpp"
 #include "text/exception/SyntaxError.hpp"
 #include "text/expression/ExpressionParser.hpp"
 #include "text/parsing/CommandParser.hpp"
 
+#include <functional>
 #include <string>
 #include <tuple>
 #include <unordered_map>
 #include <vector>
 
+#include <gmpxx.h>
 #include <mpfr.h>
 #include <mpreal.h>
 #include <boost/date_time/gregorian/gregorian.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 
 using DefaultArithmeticType = mpfr::mpreal;
-using DefaultValueType =
-    Text::Expression::ValueToken<std::nullptr_t, DefaultArithmeticType, std::string, boost::posix_time::ptime, boost::posix_time::time_duration>;
-using DefaultVariableType =
-    Text::Expression::VariableToken<std::nullptr_t, DefaultArithmeticType, std::string, boost::posix_time::ptime, boost::posix_time::time_duration>;
+using DefaultIntegerType    = mpz_class;
+using DefaultVectorType     = VectorValue<DefaultArithmeticType>;
+using DefaultValueType      = Text::Expression::ValueToken<std::nullptr_t,
+                                                           DefaultArithmeticType,
+                                                           DefaultIntegerType,
+                                                           std::string,
+                                                           boost::posix_time::ptime,
+                                                           boost::posix_time::time_duration,
+                                                           DefaultVectorType>;
+using DefaultVariableType   = Text::Expression::VariableToken<std::nullptr_t,
+                                                              DefaultArithmeticType,
+                                                              DefaultIntegerType,
+                                                              std::string,
+                                                              boost::posix_time::ptime,
+                                                              boost::posix_time::time_duration,
+                                                              DefaultVectorType>;
+using DefaultTypeList       = TypeList<std::nullptr_t,
+                                       DefaultArithmeticType,
+                                       DefaultIntegerType,
+                                       std::string,
+                                       boost::posix_time::ptime,
+                                       boost::posix_time::time_duration,
+                                       DefaultVectorType>;
+using VariableGeneratorType = DefaultArithmeticType (*)();
+
+using NativeArithmeticType = double;
+using NativeVectorType     = VectorValue<NativeArithmeticType>;
+using NativeValueType      = Text::Expression::ValueToken<std::nullptr_t, NativeArithmeticType, std::string, NativeVectorType>;
+using NativeVariableType   = Text::Expression::VariableToken<std::nullptr_t, NativeArithmeticType, std::string, NativeVectorType>;
 
 using ChemArithmeticType = mpfr::mpreal;
 using ChemValueType      = Text::Expression::ValueToken<ChemArithmeticType>;
@@ -40,27 +69,7 @@ using Text::Expression::ExpressionParser;
 using Text::Parsing::CommandParser;
 using Text::Exception::SyntaxError;
 
-inline std::unordered_map<char, std::unique_ptr<UnaryOperatorToken>> defaultUnaryOperatorCache;
-inline std::unordered_map<char, IUnaryOperatorToken*> defaultUnaryOperators;
-
-inline std::unordered_map<std::string, std::unique_ptr<BinaryOperatorToken>> defaultBinaryOperatorCache;
-inline std::unordered_map<std::string, IBinaryOperatorToken*> defaultBinaryOperators;
-
-inline std::unordered_map<std::string, std::unique_ptr<FunctionToken>> defaultFunctionCache;
-inline std::unordered_map<std::string, IFunctionToken*> defaultFunctions;
-
-inline std::unordered_map<std::string, std::unique_ptr<DefaultVariableType>> defaultUninitializedVariableCache;
-inline std::unordered_map<std::string, std::unique_ptr<DefaultVariableType>> defaultInitializedVariableCache;
-inline std::unordered_map<std::string, IVariableToken*> defaultVariables;
-
-inline std::vector<DefaultValueType> results;
-
-inline std::vector<std::tuple<const IUnaryOperatorToken*, std::string, std::string>> unaryOperatorInfoMap;
-inline std::vector<std::tuple<const IBinaryOperatorToken*, std::string, std::string>> binaryOperatorInfoMap;
-inline std::vector<std::tuple<const IFunctionToken*, std::string, std::string>> functionInfoMap;
-inline std::vector<std::tuple<const IVariableToken*, std::string, std::string>> variableInfoMap;
-
-inline bool quit = false;
+using ConverterCallbackType = std::function<IValueToken*(const std::string&)>;
 
 struct kalk_options
 {
@@ -74,18 +83,53 @@ struct kalk_options
   std::string date_ofmt;
   unsigned int seed;
   bool interactive;
+  std::size_t cache_size;
+  bool compile;
+  std::size_t memo_size;
+  unsigned int threads;
+  unsigned int agg_threads;
+  std::string engine;
+  std::size_t history;
+  std::string history_file;
+  std::string ofmt;
+  std::string ifmt;
+  std::string bind;
 };
 
-const inline kalk_options defaultOptions {128, mpfr_rnd_t::MPFR_RNDN, 30, 10, 10, -1, false, "%Y-%m-%d %H:%M:%S", 0u, false};
-inline kalk_options options {};
+const inline kalk_options defaultOptions {128,
+                                          mpfr_rnd_t::MPFR_RNDN,
+                                          30,
+                                          10,
+                                          10,
+                                          -1,
+                                          false,
+                                          "%Y-%m-%d %H:%M:%S",
+                                          0u,
+                                          false,
+                                          1024u,
+                                          true,
+                                          1024u,
+                                          1u,
+                                          0u,
+                                          "mpfr",
+                                          0u,
+                                          "",
+                                          "text",
+                                          "text",
+                                          ""};
+
+struct KalkContext;
 
 mpfr_rnd_t strToRmode(const std::string value);
 void printValue(const DefaultValueType& value);
+void printValue(const NativeValueType& value);
+DefaultValueType toDefaultValue(const NativeValueType& value);
 const DefaultValueType* ans(int index = -1);
 void list(const std::string& searchPattern = ".*");
 
-void InitDefaultExpressionParser(ExpressionParser& instance);
+void InitDefaultExpressionParser(ExpressionParser& instance, KalkContext& context);
+void InitNativeExpressionParser(ExpressionParser& instance, KalkContext& context);
 void InitChemicalExpressionParser(ExpressionParser& instance);
-void InitCommandParser(CommandParser& instance);
+void InitCommandParser(CommandParser& instance, KalkContext& context);
 
 #endif // __SETUP_HPP__
@@ -0,0 +1,168 @@
+#include "Trace.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include <unistd.h>
+
+// Events a thread collects before handing them to the writer, and bytes of JSON the writer collects before writing them out.
+static constexpr std::size_t kTraceBufferEvents = 1u << 14u;
+static constexpr std::size_t kTraceFlushBytes   = 1u << 20u;
+
+struct TraceEvent
+{
+  const char* category;
+  std::string name;
+  std::string detail;
+  TraceClock::time_point start;
+  TraceClock::time_point end;
+};
+
+class TraceWriter
+{
+  public:
+  ~TraceWriter() { Close(); }
+
+  void Open(const std::string& path)
+  {
+    m_File = std::fopen(path.c_str(), "w");
+    if(m_File == nullptr)
+    {
+      throw std::runtime_error(path + ": " + std::strerror(errno));
+    }
+
+    m_Origin = TraceClock::now();
+    m_Text   = "{\"traceEvents\":[";
+  }
+
+  void Write(const std::vector<TraceEvent>& events, unsigned int thread)
+  {
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    if(m_File == nullptr)
+    {
+      return;
+    }
+
+    for(const auto& i : events)
+    {
+      const auto start    = std::chrono::duration_cast<std::chrono::nanoseconds>(i.start - m_Origin).count();
+      const auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(i.end - i.start).count();
+      m_Text += m_First ? "\n{\"name\":\"" : ",\n{\"name\":\"";
+      m_First = false;
+      AppendEscaped(i.name);
+      m_Text += "\",\"cat\":\"";
+      m_Text += i.category;
+
+      char buffer[160];
+      std::snprintf(buffer,
+                    sizeof(buffer),
+                    "\",\"ph\":\"X\",\"ts\":%" PRId64 ".%03" PRId64 ",\"dur\":%" PRId64 ".%03" PRId64 ",\"pid\":%d,\"tid\":%u",
+                    static_cast<std::int64_t>(start / 1000),
+                    static_cast<std::int64_t>(start % 1000),
+                    static_cast<std::int64_t>(duration / 1000),
+                    static_cast<std::int64_t>(duration % 1000),
+                    static_cast<int>(getpid()),
+                    thread);
+      m_Text += buffer;
+      if(!i.detail.empty())
+      {
+        m_Text += ",\"args\":{\"detail\":\"";
+        AppendEscaped(i.detail);
+        m_Text += "\"}";
+      }
+
+      m_Text += '}';
+    }
+
+    if(m_Text.size() >= kTraceFlushBytes)
+    {
+      Flush();
+    }
+  }
+
+  void Close()
+  {
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    if(m_File == nullptr)
+    {
+      return;
+    }
+
+    m_Text += "\n],\"displayTimeUnit\":\"ns\"}\n";
+    Flush();
+    std::fclose(m_File);
+    m_File = nullptr;
+  }
+
+  private:
+  void AppendEscaped(std::string_view value)
+  {
+    for(const char i : value)
+    {
+      if(i == '"' || i == '\\')
+      {
+        m_Text += '\\';
+        m_Text += i;
+      }
+      else if(static_cast<unsigned char>(i) < 0x20u)
+      {
+        char buffer[8];
+        std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned int>(i));
+        m_Text += buffer;
+      }
+      else
+      {
+        m_Text += i;
+      }
+    }
+  }
+
+  void Flush()
+  {
+    std::fwrite(m_Text.data(), 1u, m_Text.size(), m_File);
+    m_Text.clear();
+  }
+
+  std::mutex m_Mutex;
+  std::FILE* m_File = nullptr;
+  TraceClock::time_point m_Origin;
+  std::string m_Text;
+  bool m_First = true;
+};
+
+static TraceWriter traceWriter;
+static std::atomic<unsigned int> nextTraceThread {1u};
+
+// Thread storage is destroyed before static storage, so each thread, including the main thread at exit, hands its remaining events to the writer before
+// the writer completes the file.
+struct TraceBuffer
+{
+  ~TraceBuffer() { traceWriter.Write(events, thread); }
+
+  unsigned int thread = nextTraceThread++;
+  std::vector<TraceEvent> events;
+};
+
+void openTrace(const std::string& path)
+{
+  traceWriter.Open(path);
+  traceEnabled = true;
+}
+
+void recordTraceEvent(const char* category, std::string_view name, std::string_view detail, TraceClock::time_point start, TraceClock::time_point end)
+{
+  static thread_local TraceBuffer buffer;
+  buffer.events.push_back(TraceEvent {category, std::string(name), std::string(detail), start, end});
+  if(buffer.events.size() >= kTraceBufferEvents)
+  {
+    traceWriter.Write(buffer.events, buffer.thread);
+    buffer.events.clear();
+  }
+}
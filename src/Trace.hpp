@@ -0,0 +1,53 @@
+#ifndef __TRACE_HPP__
+#define __TRACE_HPP__
+
+#include <chrono>
+#include <string>
+#include <string_view>
+
+using TraceClock = std::chrono::steady_clock;
+
+inline bool traceEnabled = false;
+
+// Starts writing Chrome trace event JSON (as read by Perfetto and chrome://tracing) to the specified file. Events are buffered per thread and written in
+// large chunks. The file is completed at exit.
+void openTrace(const std::string& path);
+// Records a complete event. The category must be a literal; the name and detail are copied.
+void recordTraceEvent(const char* category, std::string_view name, std::string_view detail, TraceClock::time_point start, TraceClock::time_point end);
+
+// Records the lifetime of the object as an event. Costs a single branch when tracing is off.
+class TraceSpan
+{
+  public:
+  TraceSpan(const char* category, std::string_view name, std::string_view detail = std::string_view())
+      : m_Active(traceEnabled)
+  {
+    if(m_Active)
+    {
+      m_Category = category;
+      m_Name     = name;
+      m_Detail   = detail;
+      m_Start    = TraceClock::now();
+    }
+  }
+
+  ~TraceSpan()
+  {
+    if(m_Active)
+    {
+      recordTraceEvent(m_Category, m_Name, m_Detail, m_Start, TraceClock::now());
+    }
+  }
+
+  TraceSpan(const TraceSpan&)            = delete;
+  TraceSpan& operator=(const TraceSpan&) = delete;
+
+  private:
+  bool m_Active;
+  const char* m_Category = nullptr;
+  std::string_view m_Name;
+  std::string_view m_Detail;
+  TraceClock::time_point m_Start;
+};
+
+#endif // __TRACE_HPP__
@@ -0,0 +1,110 @@
+#ifndef __TYPEDISPATCH_HPP__
+#define __TYPEDISPATCH_HPP__
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <typeinfo>
+#include <utility>
+
+template<class... Ts>
+struct TypeList
+{
+  static constexpr std::size_t Size = sizeof...(Ts);
+
+  template<std::size_t TIndex>
+  using At = std::tuple_element_t<TIndex, std::tuple<Ts...>>;
+
+  static std::size_t IndexOf(const std::type_info& type)
+  {
+    std::size_t result = 0u;
+    static_cast<void>(((type == typeid(Ts) || (++result, false)) || ...));
+    return result;
+  }
+};
+
+template<class TOperation, class TValue, class TTypes, class... TArgs>
+class UnaryDispatchTable
+{
+  public:
+  using ResultType  = typename TOperation::ResultType;
+  using HandlerType = ResultType (*)(const TValue&, TArgs...);
+
+  static HandlerType Find(const TValue& value)
+  {
+    const std::size_t index = TTypes::IndexOf(value.GetType());
+    return index < TTypes::Size ? s_Handlers[index] : nullptr;
+  }
+
+  private:
+  template<class T>
+  static ResultType Invoke(const TValue& value, TArgs... args) { return TOperation::Apply(value.template GetValue<T>(), std::forward<TArgs>(args)...); }
+
+  template<std::size_t TIndex>
+  static constexpr HandlerType MakeHandler()
+  {
+    using T = typename TTypes::template At<TIndex>;
+    if constexpr(TOperation::template Supports<T>)
+    {
+      return &Invoke<T>;
+    }
+    else
+    {
+      return nullptr;
+    }
+  }
+
+  template<std::size_t... TIndices>
+  static constexpr std::array<HandlerType, TTypes::Size> MakeHandlers(std::index_sequence<TIndices...>) { return {MakeHandler<TIndices>()...}; }
+
+  static const std::array<HandlerType, TTypes::Size> s_Handlers;
+};
+
+template<class TOperation, class TValue, class TTypes, class... TArgs>
+const std::array<typename UnaryDispatchTable<TOperation, TValue, TTypes, TArgs...>::HandlerType, TTypes::Size>
+    UnaryDispatchTable<TOperation, TValue, TTypes, TArgs...>::s_Handlers = MakeHandlers(std::make_index_sequence<TTypes::Size>());
+
+template<class TOperation, class TValue, class TTypes>
+class BinaryDispatchTable
+{
+  public:
+  using ResultType  = typename TOperation::ResultType;
+  using HandlerType = ResultType (*)(const TValue&, const TValue&);
+
+  static HandlerType Find(const TValue& lhs, const TValue& rhs)
+  {
+    const std::size_t lhsIndex = TTypes::IndexOf(lhs.GetType());
+    const std::size_t rhsIndex = TTypes::IndexOf(rhs.GetType());
+    return (lhsIndex < TTypes::Size && rhsIndex < TTypes::Size) ? s_Handlers[(lhsIndex * TTypes::Size) + rhsIndex] : nullptr;
+  }
+
+  private:
+  template<class TLhs, class TRhs>
+  static ResultType Invoke(const TValue& lhs, const TValue& rhs) { return TOperation::Apply(lhs.template GetValue<TLhs>(), rhs.template GetValue<TRhs>()); }
+
+  template<std::size_t TIndex>
+  static constexpr HandlerType MakeHandler()
+  {
+    using TLhs = typename TTypes::template At<TIndex / TTypes::Size>;
+    using TRhs = typename TTypes::template At<TIndex % TTypes::Size>;
+    if constexpr(TOperation::template Supports<TLhs, TRhs>)
+    {
+      return &Invoke<TLhs, TRhs>;
+    }
+    else
+    {
+      return nullptr;
+    }
+  }
+
+  template<std::size_t... TIndices>
+  static constexpr std::array<HandlerType, TTypes::Size * TTypes::Size> MakeHandlers(std::index_sequence<TIndices...>) { return {MakeHandler<TIndices>()...}; }
+
+  static const std::array<HandlerType, TTypes::Size * TTypes::Size> s_Handlers;
+};
+
+template<class TOperation, class TValue, class TTypes>
+const std::array<typename BinaryDispatchTable<TOperation, TValue, TTypes>::HandlerType, TTypes::Size * TTypes::Size>
+    BinaryDispatchTable<TOperation, TValue, TTypes>::s_Handlers = MakeHandlers(std::make_index_sequence<TTypes::Size * TTypes::Size>());
+
+#endif // __TYPEDISPATCH_HPP__
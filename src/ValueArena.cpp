@@ -0,0 +1,79 @@
+#include "ValueArena.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <iostream>
+
+#include <boost/format.hpp>
+
+static std::atomic<std::size_t> totalHeapAllocations {0u};
+static std::atomic<std::size_t> totalArenaAllocations {0u};
+static std::atomic<std::size_t> totalArenaReleases {0u};
+static std::atomic<std::size_t> totalArenaPeak {0u};
+
+AllocationCounters::~AllocationCounters()
+{
+  totalHeapAllocations += heapAllocations;
+  totalArenaAllocations += arenaAllocations;
+  totalArenaReleases += arenaReleases;
+
+  std::size_t peak = totalArenaPeak.load();
+  while(arenaPeak > peak && !totalArenaPeak.compare_exchange_weak(peak, arenaPeak)) {}
+}
+
+ValueArena::Scope::Scope(ValueArena& arena)
+    : m_Arena(arena)
+    , m_Previous(s_Current)
+{
+  s_Current = &m_Arena;
+}
+
+ValueArena::Scope::~Scope()
+{
+  s_Current = m_Previous;
+  m_Arena.Release();
+}
+
+ValueArena::~ValueArena() { Release(); }
+
+bool ValueArena::Owns(const IValueToken* value) const
+{
+  const std::less<const void*> less;
+  for(const auto& i : m_Blocks)
+  {
+    if(!less(value, i.get()) && less(value, i.get() + kBlockSize))
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void ValueArena::Release()
+{
+  if(m_Size == 0u)
+  {
+    return;
+  }
+
+  allocationCounters.arenaReleases++;
+  allocationCounters.arenaPeak = std::max(allocationCounters.arenaPeak, m_Size);
+  while(m_Size > 0u)
+  {
+    m_Size--;
+    std::launder(reinterpret_cast<DefaultValueType*>(&m_Blocks[m_Size / kBlockSize][m_Size % kBlockSize]))->~DefaultValueType();
+  }
+}
+
+void printAllocationStatistics()
+{
+  const auto& local = allocationCounters;
+  std::cerr << "Value allocations" << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Heap" % (totalHeapAllocations + local.heapAllocations)) << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Arena" % (totalArenaAllocations + local.arenaAllocations)) << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Arena releases" % (totalArenaReleases + local.arenaReleases)) << std::endl;
+  std::cerr << (boost::format("  %|1$-26|%|2$|") % "Arena peak" % std::max(totalArenaPeak.load(), local.arenaPeak)) << std::endl;
+  std::cerr << std::endl;
+}
@@ -0,0 +1,94 @@
+#ifndef __VALUEARENA_HPP__
+#define __VALUEARENA_HPP__
+
+#include "Setup.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+struct AllocationCounters
+{
+  ~AllocationCounters();
+
+  std::size_t heapAllocations  = 0u;
+  std::size_t arenaAllocations = 0u;
+  std::size_t arenaReleases    = 0u;
+  std::size_t arenaPeak        = 0u;
+};
+
+inline thread_local AllocationCounters allocationCounters;
+
+class ValueArena
+{
+  public:
+  class Scope
+  {
+    public:
+    explicit Scope(ValueArena& arena);
+    ~Scope();
+
+    Scope(const Scope&)            = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    private:
+    ValueArena& m_Arena;
+    ValueArena* m_Previous;
+  };
+
+  static constexpr std::size_t kBlockSize = 64u;
+
+  ValueArena() = default;
+  ~ValueArena();
+
+  ValueArena(const ValueArena&)            = delete;
+  ValueArena& operator=(const ValueArena&) = delete;
+
+  static ValueArena* GetCurrent() { return s_Current; }
+
+  std::size_t GetSize() const { return m_Size; }
+  bool Owns(const IValueToken* value) const;
+  void Release();
+
+  template<class... TArgs>
+  DefaultValueType* Create(TArgs&&... args)
+  {
+    if(m_Size == m_Blocks.size() * kBlockSize)
+    {
+      m_Blocks.push_back(std::make_unique<Slot[]>(kBlockSize));
+    }
+
+    auto result = new(&m_Blocks[m_Size / kBlockSize][m_Size % kBlockSize]) DefaultValueType(std::forward<TArgs>(args)...);
+    m_Size++;
+    allocationCounters.arenaAllocations++;
+    return result;
+  }
+
+  private:
+  using Slot = std::aligned_storage_t<sizeof(DefaultValueType), alignof(DefaultValueType)>;
+
+  static inline thread_local ValueArena* s_Current = nullptr;
+
+  std::vector<std::unique_ptr<Slot[]>> m_Blocks;
+  std::size_t m_Size = 0u;
+};
+
+template<class... TArgs>
+DefaultValueType* makeValue(TArgs&&... args)
+{
+  const auto arena = ValueArena::GetCurrent();
+  if(arena != nullptr)
+  {
+    return arena->Create(std::forward<TArgs>(args)...);
+  }
+
+  allocationCounters.heapAllocations++;
+  return new DefaultValueType(std::forward<TArgs>(args)...);
+}
+
+void printAllocationStatistics();
+
+#endif // __VALUEARENA_HPP__
@@ -0,0 +1,280 @@
+#include "VectorKernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define KALK_AVX2_KERNELS
+#include <immintrin.h>
+#define KALK_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+#ifdef KALK_AVX2_KERNELS
+static constexpr std::size_t kLanes = 4u;
+#endif
+
+namespace
+{
+struct Addition
+{
+  static double Apply(double lhs, double rhs) { return lhs + rhs; }
+#ifdef KALK_AVX2_KERNELS
+  KALK_TARGET_AVX2 static __m256d Apply(__m256d lhs, __m256d rhs) { return _mm256_add_pd(lhs, rhs); }
+#endif
+};
+
+struct Subtraction
+{
+  static double Apply(double lhs, double rhs) { return lhs - rhs; }
+#ifdef KALK_AVX2_KERNELS
+  KALK_TARGET_AVX2 static __m256d Apply(__m256d lhs, __m256d rhs) { return _mm256_sub_pd(lhs, rhs); }
+#endif
+};
+
+struct Multiplication
+{
+  static double Apply(double lhs, double rhs) { return lhs * rhs; }
+#ifdef KALK_AVX2_KERNELS
+  KALK_TARGET_AVX2 static __m256d Apply(__m256d lhs, __m256d rhs) { return _mm256_mul_pd(lhs, rhs); }
+#endif
+};
+
+struct Division
+{
+  static double Apply(double lhs, double rhs) { return lhs / rhs; }
+#ifdef KALK_AVX2_KERNELS
+  KALK_TARGET_AVX2 static __m256d Apply(__m256d lhs, __m256d rhs) { return _mm256_div_pd(lhs, rhs); }
+#endif
+};
+
+struct Abs
+{
+  static double Apply(double value) { return std::fabs(value); }
+#ifdef KALK_AVX2_KERNELS
+  KALK_TARGET_AVX2 static __m256d Apply(__m256d value) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), value); }
+#endif
+};
+
+struct Negate
+{
+  static double Apply(double value) { return -value; }
+#ifdef KALK_AVX2_KERNELS
+  KALK_TARGET_AVX2 static __m256d Apply(__m256d value) { return _mm256_xor_pd(_mm256_set1_pd(-0.0), value); }
+#endif
+};
+
+struct Sqrt
+{
+  static double Apply(double value) { return std::sqrt(value); }
+#ifdef KALK_AVX2_KERNELS
+  KALK_TARGET_AVX2 static __m256d Apply(__m256d value) { return _mm256_sqrt_pd(value); }
+#endif
+};
+
+struct Min
+{
+  static constexpr double kIdentity = std::numeric_limits<double>::infinity();
+
+  static double Apply(double lhs, double rhs) { return std::min(lhs, rhs); }
+#ifdef KALK_AVX2_KERNELS
+  KALK_TARGET_AVX2 static __m256d Apply(__m256d lhs, __m256d rhs) { return _mm256_min_pd(lhs, rhs); }
+#endif
+};
+
+struct Max
+{
+  static constexpr double kIdentity = -std::numeric_limits<double>::infinity();
+
+  static double Apply(double lhs, double rhs) { return std::max(lhs, rhs); }
+#ifdef KALK_AVX2_KERNELS
+  KALK_TARGET_AVX2 static __m256d Apply(__m256d lhs, __m256d rhs) { return _mm256_max_pd(lhs, rhs); }
+#endif
+};
+
+struct Sum
+{
+  static constexpr double kIdentity = 0.0;
+
+  static double Apply(double lhs, double rhs) { return lhs + rhs; }
+#ifdef KALK_AVX2_KERNELS
+  KALK_TARGET_AVX2 static __m256d Apply(__m256d lhs, __m256d rhs) { return _mm256_add_pd(lhs, rhs); }
+#endif
+};
+} // namespace
+
+template<class TOperation>
+static void
+    applyBinaryScalar(const double* lhs, std::size_t lhsStride, const double* rhs, std::size_t rhsStride, double* result, std::size_t begin, std::size_t count)
+{
+  for(std::size_t i = begin; i < count; i++)
+  {
+    result[i] = TOperation::Apply(lhs[i * lhsStride], rhs[i * rhsStride]);
+  }
+}
+
+template<class TFunction>
+static void applyUnaryScalar(const double* values, double* result, std::size_t begin, std::size_t count)
+{
+  for(std::size_t i = begin; i < count; i++)
+  {
+    result[i] = TFunction::Apply(values[i]);
+  }
+}
+
+template<class TReduction>
+static double reduceScalar(double initial, const double* values, std::size_t begin, std::size_t count)
+{
+  double result = initial;
+  for(std::size_t i = begin; i < count; i++)
+  {
+    result = TReduction::Apply(result, values[i]);
+  }
+
+  return result;
+}
+
+#ifdef KALK_AVX2_KERNELS
+KALK_TARGET_AVX2 static __m256d load(const double* values, std::size_t stride, std::size_t index)
+{
+  return stride == 0u ? _mm256_broadcast_sd(values) : _mm256_loadu_pd(values + index);
+}
+
+template<class TOperation>
+KALK_TARGET_AVX2 static void
+    applyBinaryAvx2(const double* lhs, std::size_t lhsStride, const double* rhs, std::size_t rhsStride, double* result, std::size_t count)
+{
+  std::size_t i = 0u;
+  for(; i + kLanes <= count; i += kLanes)
+  {
+    _mm256_storeu_pd(result + i, TOperation::Apply(load(lhs, lhsStride, i), load(rhs, rhsStride, i)));
+  }
+
+  applyBinaryScalar<TOperation>(lhs, lhsStride, rhs, rhsStride, result, i, count);
+}
+
+template<class TFunction>
+KALK_TARGET_AVX2 static void applyUnaryAvx2(const double* values, double* result, std::size_t count)
+{
+  std::size_t i = 0u;
+  for(; i + kLanes <= count; i += kLanes)
+  {
+    _mm256_storeu_pd(result + i, TFunction::Apply(_mm256_loadu_pd(values + i)));
+  }
+
+  applyUnaryScalar<TFunction>(values, result, i, count);
+}
+
+template<class TReduction>
+KALK_TARGET_AVX2 static double reduceAvx2(const double* values, std::size_t count)
+{
+  __m256d accumulator = _mm256_set1_pd(TReduction::kIdentity);
+  std::size_t i       = 0u;
+  for(; i + kLanes <= count; i += kLanes)
+  {
+    accumulator = TReduction::Apply(accumulator, _mm256_loadu_pd(values + i));
+  }
+
+  alignas(32) double lanes[kLanes];
+  _mm256_store_pd(lanes, accumulator);
+  return reduceScalar<TReduction>(reduceScalar<TReduction>(TReduction::kIdentity, lanes, 0u, kLanes), values, i, count);
+}
+#endif
+
+bool hasSimdKernels()
+{
+#ifdef KALK_AVX2_KERNELS
+  static const bool result = __builtin_cpu_supports("avx2") != 0;
+  return result;
+#else
+  return false;
+#endif
+}
+
+template<class TOperation>
+static void applyBinary(const double* lhs, std::size_t lhsStride, const double* rhs, std::size_t rhsStride, double* result, std::size_t count)
+{
+#ifdef KALK_AVX2_KERNELS
+  if(hasSimdKernels())
+  {
+    applyBinaryAvx2<TOperation>(lhs, lhsStride, rhs, rhsStride, result, count);
+    return;
+  }
+#endif
+
+  applyBinaryScalar<TOperation>(lhs, lhsStride, rhs, rhsStride, result, 0u, count);
+}
+
+template<class TFunction>
+static void applyUnary(const double* values, double* result, std::size_t count)
+{
+#ifdef KALK_AVX2_KERNELS
+  if(hasSimdKernels())
+  {
+    applyUnaryAvx2<TFunction>(values, result, count);
+    return;
+  }
+#endif
+
+  applyUnaryScalar<TFunction>(values, result, 0u, count);
+}
+
+template<class TReduction>
+static double reduce(const double* values, std::size_t count)
+{
+#ifdef KALK_AVX2_KERNELS
+  if(hasSimdKernels())
+  {
+    return reduceAvx2<TReduction>(values, count);
+  }
+#endif
+
+  return reduceScalar<TReduction>(TReduction::kIdentity, values, 0u, count);
+}
+
+void applyVectorOperation(VectorOperation operation,
+                          const double* lhs,
+                          std::size_t lhsStride,
+                          const double* rhs,
+                          std::size_t rhsStride,
+                          double* result,
+                          std::size_t count)
+{
+  switch(operation)
+  {
+    case VectorOperation::Addition:
+      applyBinary<Addition>(lhs, lhsStride, rhs, rhsStride, result, count);
+      break;
+    case VectorOperation::Subtraction:
+      applyBinary<Subtraction>(lhs, lhsStride, rhs, rhsStride, result, count);
+      break;
+    case VectorOperation::Multiplication:
+      applyBinary<Multiplication>(lhs, lhsStride, rhs, rhsStride, result, count);
+      break;
+    case VectorOperation::Division:
+      applyBinary<Division>(lhs, lhsStride, rhs, rhsStride, result, count);
+      break;
+  }
+}
+
+void applyVectorFunction(VectorFunction function, const double* values, double* result, std::size_t count)
+{
+  switch(function)
+  {
+    case VectorFunction::Abs:
+      applyUnary<Abs>(values, result, count);
+      break;
+    case VectorFunction::Negate:
+      applyUnary<Negate>(values, result, count);
+      break;
+    case VectorFunction::Sqrt:
+      applyUnary<Sqrt>(values, result, count);
+      break;
+  }
+}
+
+double vectorMin(const double* values, std::size_t count) { return reduce<Min>(values, count); }
+
+double vectorMax(const double* values, std::size_t count) { return reduce<Max>(values, count); }
+
+double vectorSum(const double* values, std::size_t count) { return reduce<Sum>(values, count); }
@@ -0,0 +1,37 @@
+#ifndef __VECTORKERNELS_HPP__
+#define __VECTORKERNELS_HPP__
+
+#include <cstddef>
+
+enum class VectorOperation
+{
+  Addition,
+  Subtraction,
+  Multiplication,
+  Division
+};
+
+enum class VectorFunction
+{
+  Abs,
+  Negate,
+  Sqrt
+};
+
+// Double precision elementwise kernels. AVX2 is used when the running CPU supports it, a scalar loop otherwise.
+// A stride of 0 repeats the first operand element for every result element, so a scalar broadcasts against a vector.
+bool hasSimdKernels();
+void applyVectorOperation(VectorOperation operation,
+                          const double* lhs,
+                          std::size_t lhsStride,
+                          const double* rhs,
+                          std::size_t rhsStride,
+                          double* result,
+                          std::size_t count);
+void applyVectorFunction(VectorFunction function, const double* values, double* result, std::size_t count);
+
+double vectorMin(const double* values, std::size_t count);
+double vectorMax(const double* values, std::size_t count);
+double vectorSum(const double* values, std::size_t count);
+
+#endif // __VECTORKERNELS_HPP__
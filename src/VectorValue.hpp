@@ -0,0 +1,55 @@
+#ifndef __VECTORVALUE_HPP__
+#define __VECTORVALUE_HPP__
+
+#include <cstddef>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+// Ordered sequence of numbers held by a single value token. Arithmetic on it is applied elementwise.
+template<class T>
+class VectorValue
+{
+  public:
+  using ElementType = T;
+
+  VectorValue() = default;
+  explicit VectorValue(std::size_t size)
+      : m_Elements(size)
+  {}
+  explicit VectorValue(std::vector<T> elements)
+      : m_Elements(std::move(elements))
+  {}
+
+  std::size_t GetSize() const { return m_Elements.size(); }
+  bool IsEmpty() const { return m_Elements.empty(); }
+  const std::vector<T>& GetElements() const { return m_Elements; }
+  std::vector<T>& GetElements() { return m_Elements; }
+
+  const T* GetData() const { return m_Elements.data(); }
+  T* GetData() { return m_Elements.data(); }
+
+  const T& operator[](std::size_t index) const { return m_Elements[index]; }
+  T& operator[](std::size_t index) { return m_Elements[index]; }
+
+  friend std::ostream& operator<<(std::ostream& stream, const VectorValue& value)
+  {
+    stream << '[';
+    for(std::size_t i = 0u; i < value.m_Elements.size(); i++)
+    {
+      if(i > 0u)
+      {
+        stream << ", ";
+      }
+
+      stream << value.m_Elements[i];
+    }
+
+    return stream << ']';
+  }
+
+  private:
+  std::vector<T> m_Elements;
+};
+
+#endif // __VECTORVALUE_HPP__
@@ -0,0 +1,28 @@
+#ifndef __WORKERSCOPE_HPP__
+#define __WORKERSCOPE_HPP__
+
+// Marks the current thread as a worker of some parallel evaluation for the lifetime of the scope. Code that would fan out to threads of its own runs
+// serially on a worker instead, so nested parallel work never multiplies the thread count.
+class WorkerScope
+{
+  public:
+  WorkerScope()
+      : m_Previous(s_Active)
+  {
+    s_Active = true;
+  }
+
+  ~WorkerScope() { s_Active = m_Previous; }
+
+  WorkerScope(const WorkerScope&)            = delete;
+  WorkerScope& operator=(const WorkerScope&) = delete;
+
+  static bool IsActive() { return s_Active; }
+
+  private:
+  static inline thread_local bool s_Active = false;
+
+  bool m_Previous;
+};
+
+#endif // __WORKERSCOPE_HPP__